@@ -178,6 +178,15 @@ public:
     lldb::SBError
     UnloadImage (uint32_t image_token);
 
+    //------------------------------------------------------------------
+    /// Run a command of the plug-in that implements this process, the
+    /// same as the "process plugin" command. For example, gdb-remote
+    /// processes accept "packet-stats" to get packet statistics, and
+    /// "packet-stats reset" to clear them.
+    //------------------------------------------------------------------
+    lldb::SBError
+    ExecutePluginCommand (const char *command, lldb::SBStream &output);
+
 protected:
     friend class SBAddress;
     friend class SBBreakpoint;
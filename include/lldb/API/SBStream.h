@@ -68,6 +68,7 @@ protected:
     friend class SBInstruction;
     friend class SBInstructionList;
     friend class SBModule;
+    friend class SBProcess;
     friend class SBSourceManager;
     friend class SBSymbol;
     friend class SBSymbolContext;
@@ -397,6 +397,26 @@ public:
                                               lldb::BreakpointLocationSP break_loc_sp, 
                                               Stream &error);
     
+    //------------------------------------------------------------------
+    /// Test the breakpoint's condition without running the target, if the
+    /// condition is simple enough to be interpreted by LLDB.
+    ///
+    /// @param[in] exe_ctx
+    ///    The execution context in which to evaluate this expression.
+    /// 
+    /// @param[in] error
+    ///    Error messages will be written to this stream.
+    ///
+    /// @return
+    ///     eConditionTestContinue if the condition was false,
+    ///     eConditionTestNeedsThreadPlan if it has to be run in the
+    ///     target (see GetThreadPlanToTestCondition()), and
+    ///     eConditionTestStop otherwise.  Parse and evaluation errors
+    ///     mean we should stop, and are written to \a error.
+    //------------------------------------------------------------------
+    lldb::ConditionTestResult TestConditionWithoutRunning (ExecutionContext &exe_ctx,
+                                                           Stream &error);
+    
     //------------------------------------------------------------------
     /// Return a pointer to the text of the condition expression.
     ///
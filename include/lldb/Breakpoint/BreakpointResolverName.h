@@ -80,8 +80,18 @@ protected:
     uint32_t m_func_name_type_mask;  // See FunctionNameType
     ConstString m_class_name;  // FIXME: Not used yet.  The idea would be to stop on methods of this class.
     RegularExpression m_regex;
+    // For Breakpoint::Glob, "m_basename_filter" is a glob that must match
+    // the entire demangled name (without its argument list) and this is
+    // its compiled form.
+    RegularExpression m_basename_filter_regex;
+    // For Breakpoint::Glob, the whole glob compiled so that it also
+    // matches symbol names that are followed by an argument list.
+    RegularExpression m_symbol_regex;
     Breakpoint::MatchType m_match_type;
 
+    bool
+    BasenameFilterMatches (const char *name) const;
+
 private:
     DISALLOW_COPY_AND_ASSIGN(BreakpointResolverName);
 };
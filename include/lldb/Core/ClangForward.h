@@ -121,6 +121,7 @@ namespace clang
 namespace llvm
 {
     class ExecutionEngine;
+    class Module;
 }
 
 #endif  // #if defined(__cplusplus)
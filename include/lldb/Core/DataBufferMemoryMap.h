@@ -34,6 +34,17 @@ namespace lldb_private {
 class DataBufferMemoryMap : public DataBuffer
 {
 public:
+    //------------------------------------------------------------------
+    /// How the mapped bytes are expected to be accessed. Passed along
+    /// to the host VM system as a paging hint.
+    //------------------------------------------------------------------
+    typedef enum AccessPattern
+    {
+        eAccessPatternNormal = 0,   ///< No special treatment
+        eAccessPatternSequential,   ///< Data will be walked from front to back (aggressive read ahead)
+        eAccessPatternRandom        ///< Data will be accessed in small random lookups (no read ahead)
+    } AccessPattern;
+
     //------------------------------------------------------------------
     /// Default Constructor
     //------------------------------------------------------------------
@@ -136,6 +147,19 @@ public:
     size_t
     MemoryMapFromFileDescriptor (int fd, off_t offset = 0, size_t length = SIZE_MAX);
 
+    //------------------------------------------------------------------
+    /// Tell the host how the mapped data is going to be accessed.
+    ///
+    /// @param[in] access_pattern
+    ///     The expected access pattern for the currently mapped bytes.
+    ///
+    /// @return
+    ///     \b true if there is mapped data and the hint was accepted,
+    ///     \b false otherwise.
+    //------------------------------------------------------------------
+    bool
+    SetAccessPattern (AccessPattern access_pattern);
+
 protected:
     //------------------------------------------------------------------
     // Classes that inherit from DataBufferMemoryMap can see and modify these
@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
@@ -21,7 +22,8 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/lldb-private.h"
-#include "lldb/Host/Predicate.h"
+#include "lldb/Host/Condition.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Core/Event.h"
 
 namespace lldb_private {
@@ -127,7 +129,73 @@ protected:
     };
 
     typedef std::multimap<Broadcaster*, BroadcasterInfo> broadcaster_collection;
-    typedef std::list<lldb::EventSP> event_collection;
+
+    //------------------------------------------------------------------
+    // Queued events are kept in the order they arrived in m_events, and
+    // are also indexed by broadcaster and event type in m_event_queues
+    // so that a request for events from one broadcaster, or of some
+    // types, only has to look at the first event of each matching
+    // sub-queue instead of scanning every queued event.
+    //------------------------------------------------------------------
+    typedef std::pair<Broadcaster*, uint32_t> event_key; // Broadcaster and event type
+
+    struct QueuedEvent
+    {
+        QueuedEvent (const lldb::EventSP &sp, const event_key &k) :
+            event_sp (sp),
+            key (k)
+        {
+        }
+
+        lldb::EventSP event_sp;
+        event_key key;
+    };
+
+    typedef std::map<uint64_t, QueuedEvent> event_collection;           // Events by arrival order
+    typedef std::map<event_key, std::deque<uint64_t> > event_queue_map; // Arrival order of the events for each key
+
+    //------------------------------------------------------------------
+    // A thread blocked in WaitForEventsInternal. AddEvent only wakes the
+    // waiters that want the event that was added.
+    //------------------------------------------------------------------
+    struct EventWaiter
+    {
+        EventWaiter (Broadcaster *b,
+                     const ConstString *names,
+                     uint32_t num_names,
+                     uint32_t mask) :
+            broadcaster (b),
+            broadcaster_names (names),
+            num_broadcaster_names (num_names),
+            event_type_mask (mask),
+            condition (),
+            signaled (false)
+        {
+        }
+
+        Broadcaster *broadcaster;
+        const ConstString *broadcaster_names;
+        uint32_t num_broadcaster_names;
+        uint32_t event_type_mask;
+        Condition condition;
+        bool signaled;
+    };
+
+    typedef std::list<EventWaiter *> waiter_collection;
+
+    static bool
+    EventKeyMatches (const event_key &key,
+                     Broadcaster *broadcaster,   // NULL for any broadcaster
+                     const ConstString *sources, // NULL for any event
+                     uint32_t num_sources,
+                     uint32_t event_type_mask);
+
+    // Must be called with m_events_mutex locked
+    event_collection::iterator
+    FindNextEventLocked (Broadcaster *broadcaster,   // NULL for any broadcaster
+                         const ConstString *sources, // NULL for any event
+                         uint32_t num_sources,
+                         uint32_t event_type_mask);
 
     bool
     FindNextEventInternal (Broadcaster *broadcaster,   // NULL for any broadcaster
@@ -156,8 +224,10 @@ protected:
     broadcaster_collection m_broadcasters;
     Mutex m_broadcasters_mutex; // Protects m_broadcasters
     event_collection m_events;
-    Mutex m_events_mutex; // Protects m_broadcasters and m_events
-    Predicate<bool> m_cond_wait;
+    event_queue_map m_event_queues;
+    uint64_t m_next_event_id;   // Arrival order of the next event that is added
+    waiter_collection m_waiters;
+    Mutex m_events_mutex; // Protects m_events, m_event_queues, m_next_event_id and m_waiters
 
     void
     BroadcasterWillDestruct (Broadcaster *);
@@ -46,6 +46,7 @@
 #define LLDB_LOG_OPTION_PREPEND_TIMESTAMP       (1u << 4)
 #define LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD (1u << 5)
 #define LLDB_LOG_OPTION_PREPEND_THREAD_NAME     (1U << 6)
+#define LLDB_LOG_OPTION_ASYNC                   (1U << 7)
 
 //----------------------------------------------------------------------
 // Logging Functions
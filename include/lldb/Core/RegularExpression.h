@@ -85,6 +85,31 @@ public:
     bool
     Compile (const char* re, int flags = REG_EXTENDED);
 
+    //------------------------------------------------------------------
+    /// Compile a shell style wildcard pattern.
+    ///
+    /// Converts \a glob into an extended regular expression that must
+    /// match an entire string and compiles it. "*" matches any number
+    /// of characters, "?" matches any single character, "[...]" and
+    /// "[!...]" match a set of characters and "\" makes the next
+    /// character a literal. Any literal text at the start of the
+    /// pattern becomes the required prefix (see GetRequiredPrefix()).
+    ///
+    /// @param[in] glob
+    ///     A NULL terminated C string that contains the pattern.
+    ///
+    /// @param[in] allow_argument_list
+    ///     If \b true, the string may also continue with a "(" after
+    ///     the text the pattern matches, so that demangled function
+    ///     names like "ns::Handler(int) const" match "ns::Handler".
+    ///
+    /// @return
+    ///     \b true if the pattern compiles successfully, \b false
+    ///     otherwise.
+    //------------------------------------------------------------------
+    bool
+    CompileGlob (const char* glob, bool allow_argument_list = false);
+
     //------------------------------------------------------------------
     /// Executes a regular expression.
     ///
@@ -150,6 +175,19 @@ public:
     bool
     IsValid () const;
 
+    //------------------------------------------------------------------
+    /// Get the literal prefix that every match must start with.
+    ///
+    /// @return
+    ///     The text that every string that this regular expression
+    ///     matches must start with, or NULL if the regular expression
+    ///     isn't anchored to a literal prefix. Callers can use this to
+    ///     only look at the range of a sorted list of strings that
+    ///     start with the prefix.
+    //------------------------------------------------------------------
+    const char*
+    GetRequiredPrefix () const;
+
 private:
     //------------------------------------------------------------------
     // Member variables
@@ -158,6 +196,8 @@ private:
     int m_comp_err;     ///< Error code for the regular expression compilation
     regex_t m_preg;     ///< The compiled regular expression
     mutable std::vector<regmatch_t> m_matches; ///< Where parenthesized subexpressions results are stored
+    std::string m_required_literal; ///< A string that every match must contain, used to reject strings without running the regular expression
+    bool m_required_literal_is_prefix; ///< True if every match must start with m_required_literal
 };
 
 } // namespace lldb_private
@@ -12,6 +12,7 @@
 
 #include "lldb/lldb-private.h"
 #include "lldb/Core/AddressRange.h"
+#include "lldb/Core/DataBufferMemoryMap.h"
 #include "lldb/Core/Flags.h"
 #include "lldb/Core/ModuleChild.h"
 #include "lldb/Core/ConstString.h"
@@ -230,7 +231,9 @@ public:
     IsDescendant (const Section *section);
 
     size_t
-    MemoryMapSectionDataFromObjectFile (const ObjectFile* file, DataExtractor& section_data) const;
+    MemoryMapSectionDataFromObjectFile (const ObjectFile* file,
+                                        DataExtractor& section_data,
+                                        DataBufferMemoryMap::AccessPattern access_pattern = DataBufferMemoryMap::eAccessPatternNormal) const;
 
     size_t
     ReadSectionDataFromObjectFile (const ObjectFile* objfile, off_t section_offset, void *dst, size_t dst_len) const;
@@ -12,6 +12,7 @@
 #if defined(__cplusplus)
 
 #include <memory>
+#include <string>
 #include <stdio.h>
 #include "lldb/lldb-private.h"
 #include "lldb/Host/TimeValue.h"
@@ -22,12 +23,17 @@ namespace lldb_private {
 /// @class Timer Timer.h "lldb/Core/Timer.h"
 /// @brief A timer class that simplifies common timing metrics.
 ///
-/// A scoped timer class that allows a variety of pthread mutex
-/// objects to have a mutex locked when a Timer::Locker
-/// object is created, and unlocked when it goes out of scope or
-/// when the Timer::Locker::Reset(pthread_mutex_t *)
-/// is called. This provides an exception safe way to lock a mutex
-/// in a scope.
+/// A scoped timer that measures how long it is alive, both in total
+/// and excluding the time spent in timers nested inside it on the same
+/// thread. The exclusive time is added to per-category statistics.
+///
+/// All bookkeeping is kept per thread, so timers running on different
+/// threads never contend with each other. The per-thread statistics
+/// are only merged when they are dumped. Times come from a monotonic
+/// clock so they aren't skewed by changes to the wall clock.
+///
+/// Timers can also be recorded as a timeline of nested events and
+/// written out in the Chrome trace event format (see DumpTrace()).
 //----------------------------------------------------------------------
 
 class Timer
@@ -51,23 +57,53 @@ public:
 
     static void
     SetDisplayDepth (uint32_t depth);
-    
+
     static void
     SetQuiet (bool value);
 
+    //--------------------------------------------------------------
+    /// Dump the count, total, minimum and maximum exclusive time of
+    /// each category, merged across all threads, sorted by total.
+    //--------------------------------------------------------------
     static void
     DumpCategoryTimes (Stream *s);
 
     static void
     ResetCategoryTimes ();
 
+    //--------------------------------------------------------------
+    /// Start or stop recording every timer that runs as an event in
+    /// a timeline. Starting discards any previously recorded events.
+    //--------------------------------------------------------------
+    static void
+    SetTraceEnabled (bool enabled);
+
+    static bool
+    GetTraceEnabled ();
+
+    //--------------------------------------------------------------
+    /// Write the recorded timeline from all threads to \a s as a
+    /// Chrome trace event JSON document that can be loaded into
+    /// chrome://tracing.
+    //--------------------------------------------------------------
+    static void
+    DumpTrace (Stream *s);
+
+    //--------------------------------------------------------------
+    /// Returns the current time in nanoseconds from a monotonic clock.
+    /// The value is only meaningful when compared to other values
+    /// returned by this function.
+    //--------------------------------------------------------------
+    static uint64_t
+    GetMonotonicNanoSeconds ();
+
 protected:
 
     void
-    ChildStarted (const TimeValue& time);
+    ChildStarted (uint64_t time);
 
     void
-    ChildStopped (const TimeValue& time);
+    ChildStopped (uint64_t time);
 
     uint64_t
     GetTotalElapsedNanoSeconds();
@@ -79,11 +115,12 @@ protected:
     /// Member variables
     //--------------------------------------------------------------
     const char *m_category;
-    TimeValue m_total_start;
-    TimeValue m_timer_start;
+    std::string m_name;     // The formatted description, only kept while tracing
+    uint64_t m_start;       // When this timer started, or zero if it isn't being timed
+    uint64_t m_total_start; // Monotonic start time of the running total, or zero
+    uint64_t m_timer_start; // Monotonic start time of the running exclusive time, or zero
     uint64_t m_total_ticks; // Total running time for this timer including when other timers below this are running
     uint64_t m_timer_ticks; // Ticks for this timer that do not include when other timers below this one are running
-    static uint32_t g_depth;
     static uint32_t g_display_depth;
     static FILE * g_file;
 private:
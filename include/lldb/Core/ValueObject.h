@@ -193,6 +193,37 @@ public:
     DataExtractor &
     GetDataExtractor ();
 
+    //------------------------------------------------------------------
+    /// Get the data for a child of this value object.
+    ///
+    /// The first time a child asks for its data after an update, the
+    /// memory for this whole object (or, for pointers and references,
+    /// the whole pointee) is read with a single memory read and the
+    /// data for each child is sliced out of that buffer without being
+    /// copied.
+    ///
+    /// @param[in] child_value
+    ///     The value of the child whose data is being requested. It
+    ///     must contain a load or host address.
+    ///
+    /// @param[in] child_byte_size
+    ///     The size in bytes of the child's value.
+    ///
+    /// @param[out] data
+    ///     The data extractor to fill in with the child's data.
+    ///
+    /// @return
+    ///     \b true if \a data was filled in, \b false if the child
+    ///     isn't contained in the memory for this object or that
+    ///     memory couldn't be read. The child should read its own
+    ///     data in that case.
+    //------------------------------------------------------------------
+    bool
+    GetChildData (ExecutionContextScope *exe_scope,
+                  const Value &child_value,
+                  uint32_t child_byte_size,
+                  DataExtractor &data);
+
     bool
     Write ();
 
@@ -316,6 +347,9 @@ protected:
     std::string         m_summary_str;  // Cached summary string that will get cleared if/when the value is updated.
     std::string         m_object_desc_str; // Cached result of the "object printer".  This differs from the summary
                                               // in that the summary is consed up by us, the object_desc_string is builtin.
+    DataExtractor       m_child_data;   // Memory that our children's data is sliced from, cleared when the value is updated.
+    lldb::addr_t        m_child_data_addr; // The address m_child_data was read from.
+    Value::ValueType    m_child_data_value_type; // The address type of m_child_data_addr.
     std::vector<lldb::ValueObjectSP> m_children;
     std::map<ConstString, lldb::ValueObjectSP> m_synthetic_children;
     lldb::ValueObjectSP m_dynamic_value_sp;
@@ -325,7 +359,8 @@ protected:
                         m_children_count_valid:1,
                         m_old_value_valid:1,
                         m_pointers_point_to_load_addrs:1,
-                        m_is_deref_of_parent:1;
+                        m_is_deref_of_parent:1,
+                        m_child_data_read_failed:1;
     
     friend class CommandObjectExpression;
     friend class ClangExpressionVariable;
@@ -355,6 +390,9 @@ protected:
     GetPointerValue (lldb::AddressType &address_type, 
                      bool scalar_is_load_address);
 
+    void
+    PrefetchChildCStrings (ExecutionContextScope *exe_scope);
+
     lldb::addr_t
     GetAddressOf (lldb::AddressType &address_type, 
                   bool scalar_is_load_address);
@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 
+class IRInterpreter;
+
 namespace lldb_private
 {
 
@@ -107,6 +109,11 @@ public:
     ///     expression has no side effects, this is set to the result of the 
     ///     expression.  
     ///
+    /// @param[in] interpret_if_possible
+    ///     If true and the IR only does things IRInterpreter can do, the
+    ///     code is not JIT compiled.  func_addr is left invalid and
+    ///     GetInterpreter() returns the interpreter to run instead.
+    ///
     /// @return
     ///     An error code indicating the success or failure of the operation.
     ///     Test with Success().
@@ -116,7 +123,20 @@ public:
              lldb::addr_t &func_addr,
              lldb::addr_t &func_end,
              ExecutionContext &exe_ctx,
-             lldb::ClangExpressionVariableSP *const_result = NULL);
+             lldb::ClangExpressionVariableSP *const_result = NULL,
+             bool interpret_if_possible = false);
+    
+    //------------------------------------------------------------------
+    /// Return the interpreter MakeJIT() prepared instead of JIT
+    /// compiling the expression, or NULL if the expression was JIT
+    /// compiled.  The interpreter runs its own copy of the IR, so the
+    /// module this object keeps is left as the parser produced it.
+    //------------------------------------------------------------------
+    IRInterpreter *
+    GetInterpreter ()
+    {
+        return m_interpreter.get();
+    }
     
     //------------------------------------------------------------------
     /// Disassemble the machine code for a JITted function from the target 
@@ -186,6 +206,8 @@ private:
     std::auto_ptr<clang::CodeGenerator>         m_code_generator;       ///< [owned by the Execution Engine] The Clang object that generates IR
     std::auto_ptr<llvm::ExecutionEngine>        m_execution_engine;     ///< The LLVM JIT
     std::vector<JittedFunction>                 m_jitted_functions;     ///< A vector of all functions that have been JITted into machine code (just one, if ParseExpression() was called)
+    std::auto_ptr<llvm::Module>                 m_interpreted_module;   ///< The module the parser produced, if the expression wasn't JIT compiled
+    std::auto_ptr<IRInterpreter>                m_interpreter;          ///< The interpreter, which runs a copy of m_interpreted_module
 };
     
 }
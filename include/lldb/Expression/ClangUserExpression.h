@@ -25,6 +25,7 @@
 #include "lldb/Core/ClangForward.h"
 #include "lldb/Expression/ClangExpression.h"
 #include "lldb/Expression/ClangExpressionVariable.h"
+#include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/TaggedASTType.h"
 #include "lldb/Target/Process.h"
 
@@ -69,6 +70,13 @@ public:
     //------------------------------------------------------------------
     /// Parse the expression
     ///
+    /// If the expression was already JIT compiled into the same process
+    /// for the same function, block and desired type, the code that is
+    /// in the process is reused and only the variables are materialized
+    /// again when it is executed. This makes reparsing an expression
+    /// that is evaluated over and over (like a breakpoint condition)
+    /// cheap.
+    ///
     /// @param[in] error_stream
     ///     A stream to print parse errors and warnings to.
     ///
@@ -146,6 +154,49 @@ public:
                           ExecutionContext &exe_ctx,
                           lldb::ClangExpressionVariableSP &result);
     
+    //------------------------------------------------------------------
+    /// Allow Parse() to prepare the expression to be interpreted by LLDB
+    /// instead of JIT compiling it, when the expression is simple enough
+    /// (see IRInterpreter).
+    //------------------------------------------------------------------
+    void
+    SetInterpretIfPossible (bool interpret_if_possible)
+    {
+        if (interpret_if_possible != m_interpret_if_possible)
+        {
+            m_interpret_if_possible = interpret_if_possible;
+            m_can_reuse_parse = false;
+        }
+    }
+    
+    //------------------------------------------------------------------
+    /// Return true if the parsed expression can be run with Interpret().
+    //------------------------------------------------------------------
+    bool
+    CanInterpret ();
+    
+    //------------------------------------------------------------------
+    /// Run the parsed expression inside LLDB, without running the
+    /// target.  The arguments are materialized and dematerialized just
+    /// like they are for Execute().
+    ///
+    /// @param[in] error_stream
+    ///     A stream to print errors to.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context to read variables from.
+    ///
+    /// @param[out] result
+    ///     The persistent variable holding the expression's result.
+    ///
+    /// @return
+    ///     True on success; false otherwise.
+    //------------------------------------------------------------------
+    bool
+    Interpret (Stream &error_stream,
+               ExecutionContext &exe_ctx,
+               lldb::ClangExpressionVariableSP &result);
+    
     //------------------------------------------------------------------
     /// Return the string that the parser should parse.  Must be a full
     /// translation unit.
@@ -276,6 +327,15 @@ private:
     void
     ScanContext(ExecutionContext &exe_ctx);
 
+    //------------------------------------------------------------------
+    /// Return true if the JITted or interpreted code from a previous call
+    /// to Parse() can be used for a parse in \a exe_ctx.
+    //------------------------------------------------------------------
+    bool
+    CanReuseParse (ExecutionContext &exe_ctx,
+                   TypeFromUser desired_type,
+                   bool keep_result_in_memory);
+
     bool
     PrepareToExecuteJITExpression (Stream &error_stream,
                                    ExecutionContext &exe_ctx,
@@ -291,11 +351,16 @@ private:
     std::auto_ptr<ClangExpressionDeclMap>       m_expr_decl_map;        ///< The map to use when parsing and materializing the expression.
     std::auto_ptr<ClangExpressionVariableList> m_local_variables;      ///< The local expression variables, if the expression is DWARF.
     std::auto_ptr<StreamString>                 m_dwarf_opcodes;        ///< The DWARF opcodes for the expression.  May be NULL.
+    std::auto_ptr<ClangExpressionParser>        m_parser_ap;            ///< The parser, kept only when it owns the IR for an interpreted expression.
     
     bool                                        m_cplusplus;            ///< True if the expression is compiled as a C++ member function (true if it was parsed when exe_ctx was in a C++ method).
     bool                                        m_objectivec;           ///< True if the expression is compiled as an Objective-C method (true if it was parsed when exe_ctx was in an Objective-C method).
     bool                                        m_needs_object_ptr;     ///< True if "this" or "self" must be looked up and passed in.  False if the expression doesn't really use them and they can be NULL.
     bool                                        m_const_object;         ///< True if "this" is const.
+    bool                                        m_interpret_if_possible;///< True if Parse() may prepare the expression for interpretation instead of JIT compiling it.
+    bool                                        m_keep_result_in_memory;///< The keep_result_in_memory value the code was parsed with.
+    bool                                        m_can_reuse_parse;      ///< True if the parsed code can be reused by a later parse in the same context.
+    SymbolContext                               m_parse_sym_ctx;        ///< The symbol context the code was parsed in.
 };
     
 } // namespace lldb_private
@@ -0,0 +1,152 @@
+//===-- IRInterpreter.h -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_IRInterpreter_h_
+#define liblldb_IRInterpreter_h_
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "lldb/lldb-include.h"
+
+namespace llvm {
+    class Argument;
+    class Function;
+    class Instruction;
+    class Module;
+    class TargetData;
+    class Value;
+}
+
+namespace lldb_private {
+    class ClangExpressionDeclMap;
+    class Error;
+    class ExecutionContext;
+}
+
+//----------------------------------------------------------------------
+/// @class IRInterpreter IRInterpreter.h "lldb/Expression/IRInterpreter.h"
+/// @brief Runs the IR for a simple expression inside LLDB
+///
+/// Once an expression has been parsed, converted to IR and prepared by
+/// IRForTarget, it is normally JIT compiled and run in the target.
+/// Running code in the target means resuming and stopping the process,
+/// which is slow when it happens often (for instance, for a breakpoint
+/// condition on a hot path).
+///
+/// IRInterpreter runs the IR itself instead.  It only handles integer
+/// and pointer arithmetic, comparisons, branches, and loads and stores.
+/// Loads read target memory directly, and stores may only write to
+/// memory LLDB owns: the argument struct and the memory for persistent
+/// variables (including the result).  An expression that calls a
+/// function, writes to program memory or uses anything else must be
+/// JIT compiled.
+//----------------------------------------------------------------------
+class IRInterpreter
+{
+public:
+    //------------------------------------------------------------------
+    /// Constructor
+    ///
+    /// @param[in] func_name
+    ///     The name of the function to interpret.
+    //------------------------------------------------------------------
+    IRInterpreter (const char *func_name = "$__lldb_expr");
+
+    //------------------------------------------------------------------
+    /// Destructor
+    //------------------------------------------------------------------
+    ~IRInterpreter ();
+
+    //------------------------------------------------------------------
+    /// Prepare a module that IRForTarget has processed for
+    /// interpretation.  This copies the module, promotes local variables
+    /// to registers in the copy and checks that every instruction can be
+    /// interpreted.
+    ///
+    /// @param[in] llvm_module
+    ///     The module containing the function.  It isn't modified, so it
+    ///     can still be JIT compiled if this returns false.
+    ///
+    /// @param[in] decl_map
+    ///     The DeclMap that laid out the argument struct.  Used to find
+    ///     the struct members that are persistent variables.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context the expression was parsed in.
+    ///
+    /// @return
+    ///     True if the function can be interpreted; false otherwise.
+    //------------------------------------------------------------------
+    bool
+    Prepare (llvm::Module &llvm_module,
+             lldb_private::ClangExpressionDeclMap &decl_map,
+             lldb_private::ExecutionContext &exe_ctx);
+
+    //------------------------------------------------------------------
+    /// Run the function that Prepare() accepted.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context whose process memory is used.
+    ///
+    /// @param[in] struct_address
+    ///     The address of the materialized argument struct.
+    ///
+    /// @param[in] object_ptr
+    ///     The value of "this" or "self", if the function takes one.
+    ///
+    /// @param[in] cmd_ptr
+    ///     The value of "_cmd", if the function takes one.
+    ///
+    /// @param[out] err
+    ///     Filled in if the function could not be run to completion.
+    ///
+    /// @return
+    ///     True on success; false otherwise.
+    //------------------------------------------------------------------
+    bool
+    Run (lldb_private::ExecutionContext &exe_ctx,
+         lldb::addr_t struct_address,
+         lldb::addr_t object_ptr,
+         lldb::addr_t cmd_ptr,
+         lldb_private::Error &err);
+
+private:
+    //------------------------------------------------------------------
+    /// Return true if \a inst is one of the instructions Run() knows
+    /// how to execute, with operands it can evaluate.
+    //------------------------------------------------------------------
+    bool
+    CanInterpretInstruction (llvm::Instruction &inst);
+
+    //------------------------------------------------------------------
+    /// Return true if a store to \a pointer can only write memory that
+    /// LLDB allocated for the expression.
+    //------------------------------------------------------------------
+    bool
+    IsLLDBOwnedPointer (llvm::Value *pointer);
+
+    //------------------------------------------------------------------
+    /// Return true and fill in \a offset if \a pointer is the address
+    /// of a member of the argument struct.
+    //------------------------------------------------------------------
+    bool
+    GetStructMemberOffset (llvm::Value *pointer,
+                           int64_t &offset);
+
+    std::string                         m_func_name;            ///< The name of the function to interpret
+    std::auto_ptr<llvm::Module>         m_module;               ///< The copy of the module that m_function lives in, set by Prepare()
+    llvm::Function                     *m_function;             ///< The function to interpret, set by Prepare()
+    llvm::Argument                     *m_struct_arg;           ///< The $__lldb_arg argument of m_function
+    std::auto_ptr<llvm::TargetData>     m_target_data;          ///< The target's type sizes and alignments
+    std::set<int64_t>                   m_persistent_offsets;   ///< The struct offsets of the persistent variables, whose memory LLDB owns
+};
+
+#endif
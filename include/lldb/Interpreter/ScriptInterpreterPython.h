@@ -17,6 +17,9 @@
 #include <Python.h>
 #endif
 
+#include <map>
+#include <string>
+
 #include "lldb/lldb-private.h"
 #include "lldb/Interpreter/ScriptInterpreter.h"
 #include "lldb/Core/InputReader.h"
@@ -103,6 +106,17 @@ protected:
     void
     RestoreTerminalState ();
     
+    // Returns this interpreter's session dictionary.  The Python lock must
+    // be held.
+    PyObject *
+    GetSessionDictionary ();
+
+    // Returns the breakpoint callback function with the given name, looking
+    // it up in the session dictionary the first time it is asked for.  The
+    // Python lock must be held.
+    PyObject *
+    GetBreakpointCallable (const char *python_function_name);
+
 private:
 
     static size_t
@@ -122,6 +136,8 @@ private:
     bool m_session_is_active;
     bool m_pty_slave_is_open;
     bool m_valid_session;
+    PyObject *m_session_dict;
+    std::map<std::string, PyObject *> m_breakpoint_callables;
                          
 };
 
@@ -10,6 +10,7 @@
 #ifndef liblldb_LineTable_h_
 #define liblldb_LineTable_h_
 
+#include <memory>
 #include <vector>
 
 #include "lldb/lldb-private.h"
@@ -26,6 +27,36 @@ namespace lldb_private {
 class LineTable
 {
 public:
+    //------------------------------------------------------------------
+    /// @class SequenceParser
+    /// @brief Parses the rows of a single line table sequence on demand.
+    ///
+    /// Symbol files that can find the address range of each sequence
+    /// of rows in a line table (a run of rows with increasing addresses
+    /// that ends with a terminal entry) without building the rows can
+    /// give the line table one of these along with the address ranges.
+    /// Rows then only get built for the sequences that are looked up by
+    /// address, and for all sequences when the whole table is needed.
+    //------------------------------------------------------------------
+    class SequenceParser
+    {
+    public:
+        virtual
+        ~SequenceParser ()
+        {
+        }
+
+        //--------------------------------------------------------------
+        /// Append all rows for a sequence to \a line_table using
+        /// LineTable::AppendLineEntry() in increasing address order.
+        ///
+        /// @param[in] sequence_id
+        ///     The ID that was given to LineTable::AppendSequence().
+        //--------------------------------------------------------------
+        virtual void
+        ParseSequence (LineTable &line_table, uint32_t sequence_id) = 0;
+    };
+
     //------------------------------------------------------------------
     /// Construct with compile unit.
     ///
@@ -79,6 +110,33 @@ public:
                      bool is_epilogue_begin,
                      bool is_terminal_entry);
 
+    //------------------------------------------------------------------
+    /// Set the object that parses sequences added with AppendSequence().
+    ///
+    /// @param[in] parser
+    ///     The sequence parser, the line table takes ownership of it.
+    //------------------------------------------------------------------
+    void
+    SetSequenceParser (SequenceParser *parser);
+
+    //------------------------------------------------------------------
+    /// Add a sequence of rows that will be parsed on demand by the
+    /// sequence parser.
+    ///
+    /// @param[in] file_addr
+    ///     The file address of the first row in the sequence.
+    ///
+    /// @param[in] end_file_addr
+    ///     The file address of the terminal entry of the sequence.
+    ///
+    /// @param[in] sequence_id
+    ///     The ID that is handed back to SequenceParser::ParseSequence().
+    //------------------------------------------------------------------
+    void
+    AppendSequence (lldb::addr_t file_addr, 
+                    lldb::addr_t end_file_addr, 
+                    uint32_t sequence_id);
+
     //------------------------------------------------------------------
     /// Dump all line entries in this line table to the stream \a s.
     ///
@@ -292,6 +350,19 @@ protected:
             return lhs.sect_idx < rhs.sect_idx;
         }
 
+        // Sequences are kept whole and in program order, so a sequence
+        // whose first row is "sequence_start" goes before "entry" if
+        // it starts at a lower address, or at the same address and
+        // "entry" isn't the terminal entry of an earlier sequence.
+        static bool SequenceStartsBefore (const Entry& sequence_start, const Entry& entry)
+        {
+            if (EntryAddressLessThan (sequence_start, entry))
+                return true;
+            if (EntryAddressLessThan (entry, sequence_start))
+                return false;
+            return entry.is_terminal_entry == false;
+        }
+
         //------------------------------------------------------------------
         // Member variables.
         //------------------------------------------------------------------
@@ -314,21 +385,39 @@ protected:
         Entry *a_entry;
     };
 
+    struct Sequence
+    {
+        lldb::addr_t file_addr;     ///< The file address of the first row in the sequence
+        lldb::addr_t end_file_addr; ///< The file address of the terminal entry of the sequence
+        uint32_t sequence_id;       ///< The ID to hand to the sequence parser
+        bool parsed;                ///< True once the rows for this sequence are in m_entries
+    };
+
     //------------------------------------------------------------------
     // Types
     //------------------------------------------------------------------
     typedef std::vector<lldb_private::Section*> section_collection; ///< The collection type for the line entries.
     typedef std::vector<Entry> entry_collection;    ///< The collection type for the line entries.
+    typedef std::vector<Sequence> sequence_collection; ///< The collection type for the sequences that get parsed on demand.
     //------------------------------------------------------------------
     // Member variables.
     //------------------------------------------------------------------
     CompileUnit* m_comp_unit;       ///< The compile unit that this line table belongs to.
     SectionList m_section_list; ///< The list of sections that at least one of the line entries exists in.
     entry_collection m_entries; ///< The collection of line entries in this line table.
+    sequence_collection m_sequences; ///< Sequences whose rows get parsed on demand.
+    uint32_t m_num_unparsed_sequences; ///< The number of sequences in m_sequences that haven't been parsed yet.
+    std::auto_ptr<SequenceParser> m_sequence_parser_ap; ///< Parses the rows of the sequences in m_sequences.
 
     bool
     ConvertEntryAtIndexToLineEntry (uint32_t idx, LineEntry &line_entry);
 
+    void
+    ParseSequencesContainingFileAddress (lldb::addr_t file_addr);
+
+    void
+    ParseAllSequences ();
+
     lldb_private::Section *
     GetSectionForEntryIndex (uint32_t idx);
 private:
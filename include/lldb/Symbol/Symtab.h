@@ -85,14 +85,21 @@ protected:
 
             void        InitNameIndexes ();
             void        InitAddressIndexes ();
+            void        InitSortedNameIndexes ();
+            bool        GetSymbolIndexesWithNamePrefix (const RegularExpression &regex, std::vector<uint32_t>& indexes);
+
+    // A symbol name and index that can be sorted by the name text
+    typedef std::pair<const char *, uint32_t> NameAndIndex;
 
     ObjectFile *        m_objfile;
     collection          m_symbols;
     std::vector<uint32_t> m_addr_indexes;
     UniqueCStringMap<uint32_t> m_name_to_index;
+    std::vector<NameAndIndex> m_sorted_name_indexes; // Symbol names sorted with strcmp so names with a common prefix are contiguous
     mutable Mutex       m_mutex; // Provide thread safety for this symbol table
     bool                m_addr_indexes_computed:1,
-                        m_name_indexes_computed:1;
+                        m_name_indexes_computed:1,
+                        m_sorted_name_indexes_computed:1;
 private:
 
     bool
@@ -13,7 +13,13 @@
 
 #include <map>
 
+#include "llvm/ADT/DenseMap.h"
+
 #include "lldb/lldb-private.h"
+#include "lldb/Core/Address.h"
+#include "lldb/Host/Mutex.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/UnwindPlan.h"
 
 namespace lldb_private {
 
@@ -33,6 +39,41 @@ public:
     lldb::FuncUnwindersSP
     GetFuncUnwindersContainingAddress (const Address& addr, SymbolContext &sc);
 
+    //------------------------------------------------------------------
+    /// The result of finding the unwind row for a pc in this object file.
+    ///
+    /// Deep call stacks tend to go through the same return addresses on
+    /// every stop. Unwinders can save the symbol context, UnwindPlans and
+    /// active row they found for a pc here so the next unwind through
+    /// that pc only needs to read the CFA and saved registers.
+    ///
+    /// The symbol context is stored without its module and target
+    /// shared pointers: this table is owned by the module, so keeping
+    /// a ModuleSP here would keep the module alive forever. Callers
+    /// fill them back in from the address they looked up.
+    ///
+    /// The cache may be used by several threads unwinding at once and
+    /// is cleared when it grows past kMaxCachedUnwindRows entries.
+    //------------------------------------------------------------------
+    struct CachedUnwindRow
+    {
+        SymbolContext sym_ctx;                      // module_sp and target_sp are always empty
+        bool sym_ctx_valid;
+        Address start_pc;
+        int current_offset;
+        int current_offset_backed_up_one;
+        lldb::UnwindPlanSP fast_unwind_plan_sp;     // may be NULL
+        lldb::UnwindPlanSP full_unwind_plan_sp;     // may be NULL
+        const UnwindPlan::Row *active_row;          // owned by one of the UnwindPlans above
+        int row_register_kind;
+    };
+
+    bool
+    GetCachedUnwindRow (lldb::addr_t file_addr, CachedUnwindRow &cached_row) const;
+
+    void
+    SetCachedUnwindRow (lldb::addr_t file_addr, const CachedUnwindRow &cached_row);
+
 private:
     void
     Dump (Stream &s);
@@ -46,6 +87,12 @@ private:
     ObjectFile&         m_object_file;
     collection          m_unwinds;
 
+    enum { kMaxCachedUnwindRows = 4096 };
+
+    typedef llvm::DenseMap<lldb::addr_t, CachedUnwindRow> unwind_row_collection;
+    mutable Mutex       m_unwind_rows_mutex;
+    unwind_row_collection m_unwind_rows;    // pc file address -> resolved unwind row
+
     bool                m_initialized;  // delay some initialization until ObjectFile is set up
 
     UnwindAssemblyProfiler* m_assembly_profiler;
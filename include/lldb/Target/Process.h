@@ -1373,6 +1373,50 @@ public:
                             void *buf, 
                             size_t size,
                             Error &error);
+
+    //------------------------------------------------------------------
+    /// Read a NULL terminated C string from process memory.
+    ///
+    /// The string is read through the memory cache one cache line at a
+    /// time, so we never read past the page that contains the end of
+    /// the string, and reading stops at the first NULL terminator.
+    ///
+    /// @param[in] vm_addr
+    ///     A virtual load address of the start of the C string.
+    ///
+    /// @param[out] out_str
+    ///     The characters that were read, not including the NULL
+    ///     terminator.
+    ///
+    /// @param[in] max_length
+    ///     The maximum number of characters to read.
+    ///
+    /// @return
+    ///     \b true if the NULL terminator was found, \b false if the
+    ///     string was longer than \a max_length or the memory couldn't
+    ///     be read (\a error will be set in that case). \a out_str
+    ///     contains the characters that were read either way.
+    //------------------------------------------------------------------
+    bool
+    ReadCStringFromMemory (lldb::addr_t vm_addr,
+                           std::string &out_str,
+                           size_t max_length,
+                           Error &error);
+
+    //------------------------------------------------------------------
+    /// Prefetch memory into the memory cache.
+    ///
+    /// Reads the memory cache lines that contain the addresses in
+    /// \a addrs, merging nearby lines into as few memory reads as
+    /// possible. Used when we know we are about to read a little bit
+    /// of memory at a lot of different addresses (like the C strings
+    /// for all of the children of a value).
+    ///
+    /// @param[in] addrs
+    ///     The addresses to prefetch, in any order.
+    //------------------------------------------------------------------
+    void
+    PrefetchMemory (const std::vector<lldb::addr_t> &addrs);
     
     //------------------------------------------------------------------
     /// Reads an unsigned integer of the specified byte size from 
@@ -1927,6 +1971,16 @@ protected:
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        void
+        Prefetch (Process *process,
+                  const std::vector<lldb::addr_t> &addrs);
+
+        uint32_t
+        GetCacheLineByteSize () const
+        {
+            return m_cache_line_byte_size;
+        }
         
     protected:
         typedef std::map<lldb::addr_t, lldb::DataBufferSP> collection;
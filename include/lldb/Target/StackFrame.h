@@ -171,6 +171,11 @@ protected:
     void
     UpdatePreviousFrameFromCurrentFrame (StackFrame &curr_frame);
 
+    // Keep using this frame from the previous stop in the frame list for
+    // the current stop because its CFA and pc haven't changed.
+    void
+    ReuseFrameFromPreviousStop (uint32_t frame_idx, uint32_t concrete_frame_idx);
+
     bool
     HasCachedData () const;
 private:
@@ -76,6 +76,19 @@ protected:
     Merge (std::auto_ptr<StackFrameList>& curr_ap, 
            lldb::StackFrameListSP& prev_sp);
 
+    void
+    AppendInlinedFrames (const lldb::StackFrameSP &unwind_frame_sp, 
+                         uint32_t unwind_idx, 
+                         lldb::addr_t cfa);
+
+    bool
+    GetConcreteFrameIndexes (std::vector<size_t> &concrete_frame_idxs);
+
+    bool
+    PreviousCallersMatch (const std::vector<size_t> &prev_concrete_frame_idxs,
+                          size_t prev_concrete_pos,
+                          uint32_t unwind_idx);
+
     //------------------------------------------------------------------
     // Classes that inherit from StackFrameList can see and modify these
     //------------------------------------------------------------------
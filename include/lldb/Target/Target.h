@@ -100,6 +100,12 @@ public:
     {
         m_execution_os_type = execution_os_type;
     }
+
+    uint32_t
+    GetMaximumStringSummaryLength () const
+    {
+        return m_max_string_summary_length;
+    }
     
 
 protected:
@@ -116,6 +122,7 @@ protected:
     lldb::ExecutionLevel m_execution_level;
     lldb::ExecutionMode m_execution_mode;
     lldb::ExecutionOSType m_execution_os_type;
+    uint32_t m_max_string_summary_length;
 
 };
 
@@ -263,6 +270,12 @@ public:
                       uint32_t func_name_type_mask, 
                       bool internal = false);
 
+    // Use this to create a function breakpoint by wildcard pattern in containingModule, or all modules if it is NULL
+    lldb::BreakpointSP
+    CreateFuncGlobBreakpoint (FileSpec *containingModule,
+                              const char *func_glob,
+                              bool internal = false);
+
     // Use this to create a general breakpoint:
     lldb::BreakpointSP
     CreateBreakpoint (lldb::SearchFilterSP &filter_sp,
@@ -69,6 +69,15 @@ public:
     static const ConstString &
     GetTraceThreadVarName ();
 
+    bool
+    GetFramePointerUnwindEnabled() const
+    {
+        return m_frame_pointer_unwind;
+    }
+
+    static const ConstString &
+    FramePointerUnwindVarName ();
+
 protected:
 
     void
@@ -82,6 +91,7 @@ private:
 
     std::auto_ptr<RegularExpression> m_avoid_regexp_ap;
     bool m_trace_enabled;
+    bool m_frame_pointer_unwind;
 };
 
 class Thread :
@@ -618,6 +618,16 @@ typedef enum LazyBool {
     eLazyBoolYes        = 1
 } LazyBool;
 
+//----------------------------------------------------------------------
+// The result of testing a breakpoint condition without running the
+// target.
+//----------------------------------------------------------------------
+typedef enum ConditionTestResult {
+    eConditionTestStop,             // No condition, the condition was true, or it couldn't be parsed or evaluated
+    eConditionTestContinue,         // The condition was false
+    eConditionTestNeedsThreadPlan   // The condition has to be run in the target with a thread plan
+} ConditionTestResult;
+
 //------------------------------------------------------------------
 /// Execution Level
 //------------------------------------------------------------------
@@ -847,4 +847,33 @@ SBProcess::UnloadImage (uint32_t image_token)
     return sb_error;
 }
 
+lldb::SBError
+SBProcess::ExecutePluginCommand (const char *command, SBStream &output)
+{
+    lldb::SBError sb_error;
+    if (m_opaque_sp)
+    {
+        Mutex::Locker api_locker (m_opaque_sp->GetTarget().GetAPIMutex());
+        Args args (command);
+        sb_error.SetError (m_opaque_sp->ExecutePluginCommand (args, output.get()));
+    }
+    else
+        sb_error.SetErrorString("invalid process");
+
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+    if (log)
+    {
+        SBStream sstr;
+        sb_error.GetDescription (sstr);
+        log->Printf ("SBProcess(%p)::ExecutePluginCommand (command=\"%s\", &output (%p)) => SBError (%p): %s", 
+                     m_opaque_sp.get(), 
+                     command ? command : "NULL",
+                     output.get(),
+                     sb_error.get(),
+                     sstr.GetData());
+    }
+
+    return sb_error;
+}
+
 
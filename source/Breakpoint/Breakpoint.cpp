@@ -200,6 +200,12 @@ Breakpoint::GetThreadPlanToTestCondition (ExecutionContext &exe_ctx, lldb::Break
     return m_options.GetThreadPlanToTestCondition (exe_ctx, loc_sp, error);
 }
 
+ConditionTestResult
+Breakpoint::TestConditionWithoutRunning (ExecutionContext &exe_ctx, Stream &error)
+{
+    return m_options.TestConditionWithoutRunning (exe_ctx, error);
+}
+
 const char *
 Breakpoint::GetConditionText ()
 {
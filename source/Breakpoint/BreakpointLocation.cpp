@@ -155,6 +155,15 @@ BreakpointLocation::GetThreadPlanToTestCondition (ExecutionContext &exe_ctx, Str
         return m_owner.GetThreadPlanToTestCondition (exe_ctx, my_sp, error);
 }
 
+ConditionTestResult
+BreakpointLocation::TestConditionWithoutRunning (ExecutionContext &exe_ctx, Stream &error)
+{
+    if (m_options_ap.get())
+        return m_options_ap->TestConditionWithoutRunning (exe_ctx, error);
+    else
+        return m_owner.TestConditionWithoutRunning (exe_ctx, error);
+}
+
 const char *
 BreakpointLocation::GetConditionText ()
 {
@@ -228,7 +237,21 @@ BreakpointLocation::ShouldStop (StoppointCallbackContext *context)
     
     // The SYNCHRONOUS callback says we should stop, next try the condition.
     
+    ConditionTestResult condition_result = eConditionTestStop;
     if (should_stop)
+        condition_result = TestConditionWithoutRunning (context->exe_ctx, errors);
+
+    if (condition_result != eConditionTestNeedsThreadPlan)
+    {
+        // There was no condition, or it was simple enough to test without
+        // running the target, or it couldn't be parsed
+        log = lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS);
+        if (log && errors.GetSize() > 0)
+            log->Printf("Error evaluating condition: \"%s\".\n", errors.GetData());
+        if (condition_result == eConditionTestContinue)
+            should_stop = false;
+    }
+    else
     {
         ThreadPlanSP condition_plan_sp(GetThreadPlanToTestCondition(context->exe_ctx, errors));
         log = lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS);
@@ -16,6 +16,7 @@
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StringList.h"
 #include "lldb/Core/Value.h"
+#include "lldb/Core/ValueObject.h"
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
@@ -170,15 +171,10 @@ BreakpointOptions::SetCondition (const char *condition)
     }
 }
 
-ThreadPlan * 
-BreakpointOptions::GetThreadPlanToTestCondition (ExecutionContext &exe_ctx, 
-                                                 lldb::BreakpointLocationSP break_loc_sp,
-                                                 Stream &error_stream)
+bool
+BreakpointOptions::ParseCondition (ExecutionContext &exe_ctx, 
+                                   Stream &error_stream)
 {
-    // No condition means we should stop, so return NULL.
-    if (!m_condition_ap.get())
-        return NULL;
-        
     // FIXME: I shouldn't have to do this, the process should handle it for me:
     if (!exe_ctx.process->GetDynamicCheckers())
     {
@@ -189,7 +185,7 @@ BreakpointOptions::GetThreadPlanToTestCondition (ExecutionContext &exe_ctx,
         if (!dynamic_checkers->Install(install_errors, exe_ctx))
         {
             error_stream.Printf("Couldn't install dynamic checkers into the execution context: %s\n", install_errors.GetData());
-            return NULL;
+            return false;
         }
         
         exe_ctx.process->SetDynamicCheckers(dynamic_checkers);
@@ -199,13 +195,67 @@ BreakpointOptions::GetThreadPlanToTestCondition (ExecutionContext &exe_ctx,
     ClangASTContext *ast_context = exe_ctx.target->GetScratchClangASTContext();
     TypeFromUser bool_type(ast_context->GetBuiltInType_bool(), ast_context->getASTContext());
 
-    if (!m_condition_ap->Parse (error_stream, exe_ctx, bool_type, false /* keep_in_memory */))
+    // Simple conditions are interpreted by LLDB instead of being run in
+    // the target (see TestConditionWithoutRunning).  Parse() reuses the
+    // code from the last hit when it can.
+    m_condition_ap->SetInterpretIfPossible (true);
+    
+    return m_condition_ap->Parse (error_stream, exe_ctx, bool_type, false /* keep_in_memory */);
+}
+
+ConditionTestResult
+BreakpointOptions::TestConditionWithoutRunning (ExecutionContext &exe_ctx, 
+                                                Stream &error_stream)
+{
+    // No condition means we should stop.
+    if (!m_condition_ap.get())
+        return eConditionTestStop;
+    
+    // Errors mean we should stop.  This is the only place the condition
+    // is parsed on a hit that fails to parse, so the errors are only
+    // reported once.
+    if (!ParseCondition (exe_ctx, error_stream))
+        return eConditionTestStop;
+    
+    if (!m_condition_ap->CanInterpret())
+        return eConditionTestNeedsThreadPlan;
+    
+    lldb::ClangExpressionVariableSP expr_result;
+    if (!m_condition_ap->Interpret (error_stream, exe_ctx, expr_result) || !expr_result)
+        return eConditionTestStop;
+    
+    ValueObjectSP result_sp (expr_result->GetValueObject());
+    if (result_sp)
+    {
+        Scalar scalar_value = result_sp->GetValue().ResolveValue (&exe_ctx, result_sp->GetClangAST());
+        if (scalar_value.IsValid() && scalar_value.ULongLong(1) == 0)
+            return eConditionTestContinue;
+    }
+    return eConditionTestStop;
+}
+
+ThreadPlan * 
+BreakpointOptions::GetThreadPlanToTestCondition (ExecutionContext &exe_ctx, 
+                                                 lldb::BreakpointLocationSP break_loc_sp,
+                                                 Stream &error_stream)
+{
+    // No condition means we should stop, so return NULL.
+    if (!m_condition_ap.get())
+        return NULL;
+        
+    if (!ParseCondition (exe_ctx, error_stream))
     {
         // Errors mean we should stop.
         return NULL;
     }
-    // FIXME: When we can execute static expressions without running the target, we should check that here,
-    // and return something to indicate we should stop or just continue.
+    
+    // Interpreted conditions are tested by TestConditionWithoutRunning()
+    // and have no code in the target to run.
+    if (m_condition_ap->CanInterpret())
+    {
+        error_stream.Printf("The condition has no code to run in the target.\n");
+        return NULL;
+    }
 
     ThreadPlan *new_plan = new ThreadPlanTestCondition (*exe_ctx.thread, 
                                                         exe_ctx, 
@@ -34,6 +34,8 @@ BreakpointResolverName::BreakpointResolverName
     m_func_name_type_mask (func_name_type_mask),
     m_class_name (),
     m_regex (),
+    m_basename_filter_regex (),
+    m_symbol_regex (),
     m_match_type (type)
 {
     if (func_name_type_mask == eFunctionNameTypeAuto)
@@ -87,6 +89,28 @@ BreakpointResolverName::BreakpointResolverName
                 log->Warning ("function name regexp: \"%s\" did not compile.", m_func_name.AsCString());
         }
     }
+    else if (m_match_type == Breakpoint::Glob)
+    {
+        // Globs are matched with anchored regular expressions. Any literal
+        // text at the start of the glob lets the symbol table and the
+        // debug info name indexes look at only the names with that prefix.
+        bool success = m_regex.CompileGlob (m_func_name.AsCString());
+        if (success && !m_basename_filter.empty())
+            success = m_basename_filter_regex.CompileGlob (m_basename_filter.c_str());
+        // Demangled symbol names include the argument list
+        const bool allow_argument_list = true;
+        if (success)
+            success = m_symbol_regex.CompileGlob (m_basename_filter.empty() ? m_func_name.AsCString() : m_basename_filter.c_str(),
+                                                  allow_argument_list);
+
+        if (!success)
+        {
+            LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+            if (log)
+                log->Warning ("function name glob: \"%s\" did not compile.", func_name);
+        }
+    }
 }
 
 BreakpointResolverName::BreakpointResolverName
@@ -98,6 +122,8 @@ BreakpointResolverName::BreakpointResolverName
     m_func_name (NULL),
     m_class_name (NULL),
     m_regex (func_regex),
+    m_basename_filter_regex (),
+    m_symbol_regex (),
     m_match_type (Breakpoint::Regexp)
 {
 
@@ -114,6 +140,8 @@ BreakpointResolverName::BreakpointResolverName
     m_func_name (method),
     m_class_name (class_name),
     m_regex (),
+    m_basename_filter_regex (),
+    m_symbol_regex (),
     m_match_type (type)
 {
 
@@ -182,15 +210,23 @@ BreakpointResolverName::SearchCallback
             }
             break;
         case Breakpoint::Glob:
-            if (log)
-                log->Warning ("glob is not supported yet.");
+            if (context.module_sp)
+            {
+                // Symbol names are full demangled names with their argument
+                // lists, so search with the whole glob when we were given a
+                // qualified name.
+                context.module_sp->FindSymbolsMatchingRegExAndType (m_symbol_regex, eSymbolTypeCode, sym_list);
+                context.module_sp->FindFunctions (m_regex, 
+                                                  include_symbols, 
+                                                  append, 
+                                                  func_list);
+            }
             break;
     }
     
     if (!m_basename_filter.empty())
     {
-        // Filter out any matches whose names don't contain the basename filter
-        const char *basename_filter = m_basename_filter.c_str();
+        // Filter out any matches whose names don't match the basename filter
         if (func_list.GetSize())
         {
             bool remove = false;
@@ -209,10 +245,10 @@ BreakpointResolverName::SearchCallback
 
                     if (inlined_info)
                     {
-                        if (::strstr (inlined_info->GetName().AsCString(), basename_filter) == NULL)
+                        if (!BasenameFilterMatches (inlined_info->GetName().AsCString()))
                             remove = true;
                     }
-                    else if (::strstr (sc.function->GetName().AsCString(), basename_filter) == NULL)
+                    else if (!BasenameFilterMatches (sc.function->GetName().AsCString()))
                         remove = true;
                 }
 
@@ -234,7 +270,7 @@ BreakpointResolverName::SearchCallback
                     remove = true;
                 else if (sc.symbol == NULL)
                     remove = true;
-                else if (::strstr (sc.symbol->GetName().AsCString(), basename_filter) == NULL)
+                else if (!BasenameFilterMatches (sc.symbol->GetName().AsCString()))
                     remove = true;
 
                 if (remove)
@@ -352,6 +388,28 @@ BreakpointResolverName::SearchCallback
     return Searcher::eCallbackReturnContinue;
 }
 
+bool
+BreakpointResolverName::BasenameFilterMatches (const char *name) const
+{
+    if (name == NULL)
+        return false;
+    // Globs must match the whole name, exact names only need to be contained
+    if (m_match_type == Breakpoint::Glob)
+    {
+        // Demangled function and symbol names include the argument list,
+        // as in "ns::Handler(int)", which the glob isn't written against
+        const char *args = ::strchr (name, '(');
+        // "operator()" has parens in its name
+        while (args && args - name >= 8 && ::strncmp (args - 8, "operator", 8) == 0 && args[1] == ')')
+            args = ::strchr (args + 2, '(');
+        if (args == NULL)
+            return m_basename_filter_regex.Execute (name);
+        const std::string basename (name, args - name);
+        return m_basename_filter_regex.Execute (basename.c_str());
+    }
+    return ::strstr (name, m_basename_filter.c_str()) != NULL;
+}
+
 Searcher::Depth
 BreakpointResolverName::GetDepth()
 {
@@ -363,6 +421,8 @@ BreakpointResolverName::GetDescription (Stream *s)
 {
     if (m_match_type == Breakpoint::Regexp)
         s->Printf("regex = '%s'", m_regex.GetText());
+    else if (m_match_type == Breakpoint::Glob)
+        s->Printf("glob = '%s'", m_basename_filter.empty() ? m_func_name.AsCString() : m_basename_filter.c_str());
     else if (m_basename_filter.empty())
         s->Printf("name = '%s'", m_func_name.AsCString());
     else
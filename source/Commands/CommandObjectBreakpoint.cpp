@@ -56,6 +56,7 @@ CommandObjectBreakpointSet::CommandOptions::CommandOptions() :
     m_func_name (),
     m_func_name_type_mask (0),
     m_func_regexp (),
+    m_func_glob (),
     m_modules (),
     m_load_addr(),
     m_ignore_count (0),
@@ -124,6 +125,9 @@ CommandObjectBreakpointSet::CommandOptions::g_option_table[] =
     { LLDB_OPT_SET_8, true, "basename", 'b', required_argument, NULL, CommandCompletions::eSymbolCompletion, eArgTypeFunctionName,
         "Set the breakpoint by function basename (C++ namespaces and arguments will be ignored)." },
 
+    { LLDB_OPT_SET_9, true, "func-glob", 'G', required_argument, NULL, CommandCompletions::eSymbolCompletion, eArgTypeFunctionName,
+        "Set the breakpoint by function name, matching a shell style wildcard pattern ('*', '?' and '[...]') to find the function name(s)." },
+
     { 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
 };
 
@@ -191,6 +195,10 @@ CommandObjectBreakpointSet::CommandOptions::SetOptionValue (int option_idx, cons
             m_func_regexp = option_arg;
             break;
 
+        case 'G':
+            m_func_glob = option_arg;
+            break;
+
         case 's':
             {
                 m_modules.push_back (std::string (option_arg));
@@ -243,6 +251,7 @@ CommandObjectBreakpointSet::CommandOptions::ResetOptionValues ()
     m_func_name.clear();
     m_func_name_type_mask = 0;
     m_func_regexp.clear();
+    m_func_glob.clear();
     m_load_addr = LLDB_INVALID_ADDRESS;
     m_modules.clear();
     m_ignore_count = 0;
@@ -295,6 +304,7 @@ CommandObjectBreakpointSet::Execute
     //   2).  -a  [-s -g]         (setting breakpoint by address)
     //   3).  -n  [-s -g]         (setting breakpoint by function name)
     //   4).  -r  [-s -g]         (setting breakpoint by function name regular expression)
+    //   5).  -G  [-s -g]         (setting breakpoint by function name wildcard pattern)
 
     BreakpointSetType break_type = eSetTypeInvalid;
 
@@ -306,6 +316,8 @@ CommandObjectBreakpointSet::Execute
         break_type = eSetTypeFunctionName;
     else if  (!m_options.m_func_regexp.empty())
         break_type = eSetTypeFunctionRegexp;
+    else if  (!m_options.m_func_glob.empty())
+        break_type = eSetTypeFunctionGlob;
 
     ModuleSP module_sp = target->GetExecutableModule();
     Breakpoint *bp = NULL;
@@ -472,6 +484,38 @@ CommandObjectBreakpointSet::Execute
             }
             break;
 
+        case eSetTypeFunctionGlob: // Breakpoint by function name wildcard pattern
+            {
+                if (use_module)
+                {
+                    for (int i = 0; i < num_modules; ++i)
+                    {
+                        module_spec.SetFile(m_options.m_modules[i].c_str(), false);
+                        bp = target->CreateFuncGlobBreakpoint (&module_spec, m_options.m_func_glob.c_str()).get();
+                        if (bp)
+                        {
+                            Stream &output_stream = result.GetOutputStream();
+                            output_stream.Printf ("Breakpoint created: ");
+                            bp->GetDescription(&output_stream, lldb::eDescriptionLevelBrief);
+                            output_stream.EOL();
+                            if (bp->GetNumLocations() == 0)
+                                output_stream.Printf ("WARNING:  Unable to resolve breakpoint to any actual"
+                                                      " locations.\n");
+                            result.SetStatus (eReturnStatusSuccessFinishResult);
+                        }
+                        else
+                        {
+                            result.AppendErrorWithFormat("Breakpoint creation failed: No breakpoint created in module '%s'.\n",
+                                                        m_options.m_modules[i].c_str());
+                            result.SetStatus (eReturnStatusFailed);
+                        }
+                    }
+                }
+                else
+                    bp = target->CreateFuncGlobBreakpoint (NULL, m_options.m_func_glob.c_str()).get();
+            }
+            break;
+
         default:
             break;
     }
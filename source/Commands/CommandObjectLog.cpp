@@ -197,6 +197,7 @@ public:
             case 'T':  log_options |= LLDB_LOG_OPTION_PREPEND_TIMESTAMP;      break;
             case 'p':  log_options |= LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD;break;
             case 'n':  log_options |= LLDB_LOG_OPTION_PREPEND_THREAD_NAME;    break;
+            case 'a':  log_options |= LLDB_LOG_OPTION_ASYNC;                  break;
             default:
                 error.SetErrorStringWithFormat ("Unrecognized option '%c'\n", short_option);
                 break;
@@ -246,6 +247,7 @@ CommandObjectLogEnable::CommandOptions::g_option_table[] =
 { LLDB_OPT_SET_1, false, "timestamp",  'T', no_argument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with a timestamp." },
 { LLDB_OPT_SET_1, false, "pid-tid",    'p', no_argument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with the process and thread ID that generates the log line." },
 { LLDB_OPT_SET_1, false, "thread-name",'n', no_argument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with the thread name for the thread that generates the log line." },
+{ LLDB_OPT_SET_1, false, "async",      'a', no_argument,       NULL, 0, eArgTypeNone,       "Write log lines from a background thread so that logging doesn't slow down the threads that log." },
 { 0, false, NULL,                       0,  0,                 NULL, 0, eArgTypeNone,       NULL }
 };
 
@@ -413,7 +415,7 @@ public:
         CommandObject (interpreter, 
                        "log timers",
                        "Enable, disable, dump, and reset LLDB internal performance timers.",
-                       "log timers < enable <depth> | disable | dump | increment <bool> | reset >")
+                       "log timers < enable <depth> | disable | dump | increment <bool> | reset | trace <bool> | dump-trace <file> >")
     {
     }
 
@@ -484,6 +486,30 @@ public:
                 else
                     result.AppendError("Could not convert increment value to boolean.");
             }
+            else if (strcasecmp(sub_command, "trace") == 0)
+            {
+                bool success;
+                bool trace = Args::StringToBoolean(args.GetArgumentAtIndex(1), false, &success);
+                if (success)
+                {
+                    Timer::SetTraceEnabled (trace);
+                    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+                }
+                else
+                    result.AppendError("Could not convert trace value to boolean.");
+            }
+            else if (strcasecmp(sub_command, "dump-trace") == 0)
+            {
+                const char *path = args.GetArgumentAtIndex(1);
+                StreamFile trace_file (path);
+                if (trace_file.GetFile().IsValid())
+                {
+                    Timer::DumpTrace (&trace_file);
+                    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+                }
+                else
+                    result.AppendErrorWithFormat("Could not open '%s' for writing.\n", path);
+            }
         }
         
         if (!result.Succeeded())
@@ -1871,6 +1871,61 @@ CommandObjectProcessHandle::CommandOptions::g_option_table[] =
 { 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectProcessPlugin
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessPlugin
+
+class CommandObjectProcessPlugin : public CommandObject
+{
+public:
+
+    CommandObjectProcessPlugin (CommandInterpreter &interpreter) :
+        CommandObject (interpreter,
+                       "process plugin",
+                       "Send a command to the plug-in of the current process. With no arguments, list the commands the plug-in supports.",
+                       "process plugin [<plug-in command> [<arguments>]]",
+                       0)
+    {
+    }
+
+    ~CommandObjectProcessPlugin ()
+    {
+    }
+
+    bool
+    Execute (Args& command,
+             CommandReturnObject &result)
+    {
+        Process *process = m_interpreter.GetDebugger().GetExecutionContext().process;
+        if (process == NULL)
+        {
+            result.AppendError ("no process");
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        if (command.GetArgumentCount() == 0)
+        {
+            process->GetPluginCommandHelp (NULL, &result.GetOutputStream());
+            result.SetStatus (eReturnStatusSuccessFinishResult);
+            return true;
+        }
+
+        Error error (process->ExecutePluginCommand (command, &result.GetOutputStream()));
+        if (error.Success())
+        {
+            result.SetStatus (eReturnStatusSuccessFinishResult);
+        }
+        else
+        {
+            result.AppendError (error.AsCString());
+            result.SetStatus (eReturnStatusFailed);
+        }
+        return result.Succeeded();
+    }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectMultiwordProcess
 //-------------------------------------------------------------------------
@@ -1893,6 +1948,7 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess (CommandInterpreter
     LoadSubCommand ("status",      CommandObjectSP (new CommandObjectProcessStatus (interpreter)));
     LoadSubCommand ("interrupt",   CommandObjectSP (new CommandObjectProcessInterrupt (interpreter)));
     LoadSubCommand ("kill",        CommandObjectSP (new CommandObjectProcessKill (interpreter)));
+    LoadSubCommand ("plugin",      CommandObjectSP (new CommandObjectProcessPlugin (interpreter)));
 }
 
 CommandObjectMultiwordProcess::~CommandObjectMultiwordProcess ()
@@ -89,6 +89,28 @@ DataBufferMemoryMap::Clear()
 }
 
 
+//----------------------------------------------------------------------
+// Give the host VM system a hint about how the mapped pages will be
+// touched so it can tune read ahead (sequential walks such as DWARF
+// indexing) or avoid it (random lookups such as string tables).
+//----------------------------------------------------------------------
+bool
+DataBufferMemoryMap::SetAccessPattern (AccessPattern access_pattern)
+{
+    if (m_mmap_addr == NULL || m_mmap_size == 0)
+        return false;
+
+    int advice;
+    switch (access_pattern)
+    {
+    case eAccessPatternSequential:  advice = MADV_SEQUENTIAL; break;
+    case eAccessPatternRandom:      advice = MADV_RANDOM;     break;
+    default:                        advice = MADV_NORMAL;     break;
+    }
+    // m_mmap_addr is always page aligned since it came from mmap()
+    return ::madvise ((void *)m_mmap_addr, m_mmap_size, advice) == 0;
+}
+
 const Error &
 DataBufferMemoryMap::GetError() const
 {
@@ -9,6 +9,11 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <string.h>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <bitset>
 #include <string>
@@ -27,6 +32,43 @@
 using namespace lldb;
 using namespace lldb_private;
 
+//----------------------------------------------------------------------
+// Returns the number of bytes in the LEB128 number that starts at
+// "src", including the terminating byte (the first byte without the
+// high bit set), or zero if the number isn't terminated before "end".
+//
+// Most LEB128 numbers are a single byte so that is checked first. When
+// SSE2 is available and there are at least 16 bytes left, the high bits
+// of 16 bytes are checked at once.
+//----------------------------------------------------------------------
+static inline uint32_t
+LEB128ByteSize (const uint8_t *src, const uint8_t *end)
+{
+    if (src >= end)
+        return 0;
+    if ((*src & 0x80) == 0)
+        return 1;
+#if defined (__SSE2__)
+    if (end - src >= 16)
+    {
+        // One bit per byte, set if the byte has its high bit set
+        const uint32_t continuation_mask = _mm_movemask_epi8 (_mm_loadu_si128 ((const __m128i *)src));
+        const uint32_t terminator_mask = ~continuation_mask & 0xffffu;
+        if (terminator_mask)
+            return __builtin_ctz (terminator_mask) + 1;
+        // A 16 byte LEB128 number is bigger than anything we can extract,
+        // let the scalar loop below find the end
+    }
+#endif
+    const uint8_t *pos = src;
+    while (pos < end)
+    {
+        if ((*pos++ & 0x80) == 0)
+            return pos - src;
+    }
+    return 0;
+}
+
 static inline uint16_t 
 ReadInt16(const unsigned char* ptr, unsigned offset) 
 {
@@ -1056,15 +1098,20 @@ DataExtractor::GetCStr (uint32_t *offset_ptr) const
     const char *s = NULL;
     if ( m_start < m_end )
     {
-        s = (char*)m_start + *offset_ptr;
-
-        size_t length = strlen(s) + 1;
+        const uint8_t *start = m_start + *offset_ptr;
+        if (start >= m_end)
+            return NULL;
 
-        if (!ValidOffsetForDataOfSize(*offset_ptr, length))
+        // Find the NULL terminator without reading past the end of our
+        // data. The host memchr() scans many bytes at a time with vector
+        // instructions, unlike a byte by byte loop.
+        const uint8_t *nul = (const uint8_t *)::memchr (start, 0, m_end - start);
+        if (nul == NULL)
             return NULL;
 
+        s = (const char *)start;
         // Advance the offset
-        *offset_ptr += length;
+        *offset_ptr += nul - start + 1;
     }
     return s;
 }
@@ -1099,19 +1146,30 @@ DataExtractor::GetULEB128 (uint32_t *offset_ptr) const
     uint64_t result = 0;
     if ( m_start < m_end )
     {
-        int shift = 0;
         const uint8_t *src = m_start + *offset_ptr;
-        uint8_t byte;
-        int bytecount = 0;
 
-        while (src < m_end)
+        // Fast path for single byte values which are the most common
+        if (src < m_end && (*src & 0x80) == 0)
         {
-            bytecount++;
-            byte = *src++;
-            result |= (byte & 0x7f) << shift;
-            shift += 7;
-            if ((byte & 0x80) == 0)
-                break;
+            *offset_ptr += 1;
+            return *src;
+        }
+
+        uint32_t bytecount = LEB128ByteSize (src, m_end);
+        if (bytecount == 0)
+        {
+            // Unterminated, decode what we have like we always have
+            if (src < m_end)
+                bytecount = m_end - src;
+        }
+
+        // We know how many bytes there are, no need to bounds check
+        // each one or look for the terminator
+        int shift = 0;
+        for (uint32_t i=0; i<bytecount; ++i, shift += 7)
+        {
+            if (shift < 64)
+                result |= (uint64_t)(src[i] & 0x7f) << shift;
         }
 
         *offset_ptr += bytecount;
@@ -1134,27 +1192,43 @@ DataExtractor::GetSLEB128 (uint32_t *offset_ptr) const
 
     if ( m_start < m_end )
     {
-        int shift = 0;
-        int size = sizeof (uint32_t) * 8;
         const uint8_t *src = m_start + *offset_ptr;
 
-        uint8_t byte = 0;
-        int bytecount = 0;
+        // Fast path for single byte values which are the most common
+        if (src < m_end && (*src & 0x80) == 0)
+        {
+            *offset_ptr += 1;
+            // Sign bit of byte is 2nd high order bit (0x40)
+            return (*src & 0x40) ? (int64_t)*src - 0x80 : (int64_t)*src;
+        }
 
-        while (src < m_end)
+        uint32_t bytecount = LEB128ByteSize (src, m_end);
+        if (bytecount == 0)
         {
-            bytecount++;
-            byte = *src++;
-            result |= (byte & 0x7f) << shift;
+            // Unterminated, decode what we have like we always have
+            if (src < m_end)
+                bytecount = m_end - src;
+        }
+
+        // Accumulate unsigned so that shifting into the sign bit (shift
+        // of 63) is well defined
+        const int size = sizeof (int64_t) * 8;
+        int shift = 0;
+        uint8_t byte = 0;
+        uint64_t value = 0;
+        for (uint32_t i=0; i<bytecount; ++i)
+        {
+            byte = src[i];
+            if (shift < size)
+                value |= (uint64_t)(byte & 0x7f) << shift;
             shift += 7;
-            if ((byte & 0x80) == 0)
-                break;
         }
 
         // Sign bit of byte is 2nd high order bit (0x40)
         if (shift < size && (byte & 0x40))
-            result |= - (1 << shift);
+            value |= ~(uint64_t)0 << shift;
 
+        result = (int64_t)value;
         *offset_ptr += bytecount;
     }
     return result;
@@ -1174,13 +1248,13 @@ DataExtractor::Skip_LEB128 (uint32_t *offset_ptr) const
     uint32_t bytes_consumed = 0;
     if ( m_start < m_end )
     {
-        const uint8_t *start = m_start + *offset_ptr;
-        const uint8_t *src = start;
+        const uint8_t *src = m_start + *offset_ptr;
 
-        while ((src < m_end) && (*src++ & 0x80))
-            ++bytes_consumed;
+        bytes_consumed = LEB128ByteSize (src, m_end);
+        if (bytes_consumed == 0 && src < m_end)
+            bytes_consumed = m_end - src;   // Unterminated, skip to the end
 
-        *offset_ptr += src - start;
+        *offset_ptr += bytes_consumed;
     }
     return bytes_consumed;
 }
@@ -19,7 +19,6 @@
 #include "lldb/Core/Event.h"
 #include "lldb/Host/TimeValue.h"
 #include "lldb/lldb-private-log.h"
-#include <algorithm>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -29,8 +28,10 @@ Listener::Listener(const char *name) :
     m_broadcasters(),
     m_broadcasters_mutex (Mutex::eMutexTypeRecursive),
     m_events (),
-    m_events_mutex (Mutex::eMutexTypeRecursive),
-    m_cond_wait()
+    m_event_queues (),
+    m_next_event_id (0),
+    m_waiters (),
+    m_events_mutex (Mutex::eMutexTypeRecursive)
 {
     LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_OBJECT));
     if (log)
@@ -53,8 +54,6 @@ Listener::Clear()
     for (pos = m_broadcasters.begin(); pos != end; ++pos)
         pos->first->RemoveListener (this, pos->second.event_mask);
     m_broadcasters.clear();
-    m_cond_wait.SetValue (false, eBroadcastNever);
-    m_broadcasters.clear();
 }
 
 uint32_t
@@ -146,18 +145,14 @@ Listener::BroadcasterWillDestruct (Broadcaster *broadcaster)
     {
         Mutex::Locker event_locker(m_events_mutex);
         // Remove all events for this broadcaster object.
-        event_collection::iterator pos = m_events.begin();
-        while (pos != m_events.end())
+        event_queue_map::iterator pos = m_event_queues.lower_bound (event_key (broadcaster, 0));
+        while (pos != m_event_queues.end() && pos->first.first == broadcaster)
         {
-            if ((*pos)->GetBroadcaster() == broadcaster)
-                pos = m_events.erase(pos);
-            else
-                ++pos;
+            std::deque<uint64_t>::const_iterator id_pos, id_end = pos->second.end();
+            for (id_pos = pos->second.begin(); id_pos != id_end; ++id_pos)
+                m_events.erase (*id_pos);
+            m_event_queues.erase (pos++);
         }
-
-        if (m_events.empty())
-            m_cond_wait.SetValue (false, eBroadcastNever);
-
     }
 }
 
@@ -168,78 +163,109 @@ Listener::AddEvent (EventSP &event_sp)
     if (log)
         log->Printf ("%p Listener('%s')::AddEvent (event_sp = {%p})", this, m_name.c_str(), event_sp.get());
 
-    // Scope for "locker"
+    Mutex::Locker locker(m_events_mutex);
+    const event_key key (event_sp->GetBroadcaster(), event_sp->GetType());
+    const uint64_t event_id = m_next_event_id++;
+    m_events.insert (std::make_pair (event_id, QueuedEvent (event_sp, key)));
+    m_event_queues[key].push_back (event_id);
+
+    // Only wake up the threads that are waiting for this kind of event
+    waiter_collection::iterator pos, end = m_waiters.end();
+    for (pos = m_waiters.begin(); pos != end; ++pos)
     {
-        Mutex::Locker locker(m_events_mutex);
-        m_events.push_back (event_sp);
+        EventWaiter *waiter = *pos;
+        if (!waiter->signaled && EventKeyMatches (key,
+                                                  waiter->broadcaster,
+                                                  waiter->broadcaster_names,
+                                                  waiter->num_broadcaster_names,
+                                                  waiter->event_type_mask))
+        {
+            waiter->signaled = true;
+            waiter->condition.Signal();
+        }
     }
-    m_cond_wait.SetValue (true, eBroadcastAlways);
 }
 
-class EventBroadcasterMatches
+bool
+Listener::EventKeyMatches
+(
+    const event_key &key,
+    Broadcaster *broadcaster,   // NULL for any broadcaster
+    const ConstString *broadcaster_names, // NULL for any event
+    uint32_t num_broadcaster_names,
+    uint32_t event_type_mask
+)
 {
-public:
-    EventBroadcasterMatches (Broadcaster *broadcaster) :
-        m_broadcaster (broadcaster)    {
-    }
+    if (broadcaster && key.first != broadcaster)
+        return false;
 
-    bool operator() (const EventSP &event_sp) const
+    if (broadcaster_names)
     {
-        if (event_sp->BroadcasterIs(m_broadcaster))
-            return true;
-        else
+        bool found_source = false;
+        const ConstString &event_broadcaster_name = key.first->GetBroadcasterName();
+        for (uint32_t i=0; i<num_broadcaster_names; ++i)
+        {
+            if (broadcaster_names[i] == event_broadcaster_name)
+            {
+                found_source = true;
+                break;
+            }
+        }
+        if (!found_source)
             return false;
     }
 
-private:
-    Broadcaster *m_broadcaster;
-
-};
+    if (event_type_mask == 0 || event_type_mask & key.second)
+        return true;
+    return false;
+}
 
-class EventMatcher
+Listener::event_collection::iterator
+Listener::FindNextEventLocked
+(
+    Broadcaster *broadcaster,   // NULL for any broadcaster
+    const ConstString *broadcaster_names, // NULL for any event
+    uint32_t num_broadcaster_names,
+    uint32_t event_type_mask
+)
 {
-public:
-    EventMatcher (Broadcaster *broadcaster, const ConstString *broadcaster_names, uint32_t num_broadcaster_names, uint32_t event_type_mask) :
-        m_broadcaster (broadcaster),
-        m_broadcaster_names (broadcaster_names),
-        m_num_broadcaster_names (num_broadcaster_names),
-        m_event_type_mask (event_type_mask)
-    {
-    }
+    if (m_events.empty())
+        return m_events.end();
+
+    if (broadcaster == NULL && broadcaster_names == NULL && event_type_mask == 0)
+        return m_events.begin();
 
-    bool operator() (const EventSP &event_sp) const
+    // The oldest matching event is at the front of one of the sub-queues
+    // whose key matches, so we only need to compare their first events.
+    // The sub-queues of one broadcaster are next to each other.
+    event_queue_map::const_iterator pos, end = m_event_queues.end();
+    if (broadcaster)
+        pos = m_event_queues.lower_bound (event_key (broadcaster, 0));
+    else
+        pos = m_event_queues.begin();
+
+    bool found = false;
+    uint64_t oldest_event_id = 0;
+    for (; pos != end; ++pos)
     {
-        if (m_broadcaster && !event_sp->BroadcasterIs(m_broadcaster))
-            return false;
+        if (broadcaster && pos->first.first != broadcaster)
+            break;
 
-        if (m_broadcaster_names)
+        if (EventKeyMatches (pos->first, broadcaster, broadcaster_names, num_broadcaster_names, event_type_mask))
         {
-            bool found_source = false;
-            const ConstString &event_broadcaster_name = event_sp->GetBroadcaster()->GetBroadcasterName();
-            for (uint32_t i=0; i<m_num_broadcaster_names; ++i)
+            const uint64_t event_id = pos->second.front();
+            if (!found || event_id < oldest_event_id)
             {
-                if (m_broadcaster_names[i] == event_broadcaster_name)
-                {
-                    found_source = true;
-                    break;
-                }
+                oldest_event_id = event_id;
+                found = true;
             }
-            if (!found_source)
-                return false;
         }
-
-        if (m_event_type_mask == 0 || m_event_type_mask & event_sp->GetType())
-            return true;
-        return false;
     }
 
-private:
-    Broadcaster *m_broadcaster;
-    const ConstString *m_broadcaster_names;
-    const uint32_t m_num_broadcaster_names;
-    const uint32_t m_event_type_mask;
-};
-
+    if (found)
+        return m_events.find (oldest_event_id);
+    return m_events.end();
+}
 
 bool
 Listener::FindNextEventInternal
@@ -255,30 +281,26 @@ Listener::FindNextEventInternal
 
     Mutex::Locker lock(m_events_mutex);
 
-    if (m_events.empty())
-        return false;
-
-
-    Listener::event_collection::iterator pos = m_events.end();
-
-    if (broadcaster == NULL && broadcaster_names == NULL && event_type_mask == 0)
-    {
-        pos = m_events.begin();
-    }
-    else
-    {
-        pos = std::find_if (m_events.begin(), m_events.end(), EventMatcher (broadcaster, broadcaster_names, num_broadcaster_names, event_type_mask));
-    }
+    Listener::event_collection::iterator pos = FindNextEventLocked (broadcaster,
+                                                                    broadcaster_names,
+                                                                    num_broadcaster_names,
+                                                                    event_type_mask);
 
     if (pos != m_events.end())
     {
-        event_sp = *pos;
+        event_sp = pos->second.event_sp;
         if (remove)
         {
+            // Events leave a sub-queue in the order they arrived, so this
+            // event is always the first one in its sub-queue.
+            event_queue_map::iterator queue_pos = m_event_queues.find (pos->second.key);
+            if (queue_pos != m_event_queues.end())
+            {
+                queue_pos->second.pop_front();
+                if (queue_pos->second.empty())
+                    m_event_queues.erase (queue_pos);
+            }
             m_events.erase(pos);
-
-            if (m_events.empty())
-                m_cond_wait.SetValue (false, eBroadcastNever);
         }
         
         // Unlock the event queue here.  We've removed this event and are about to return
@@ -379,11 +401,27 @@ Listener::WaitForEventsInternal
         if (GetNextEventInternal (broadcaster, broadcaster_names, num_broadcaster_names, event_type_mask, event_sp))
             return true;
 
-        // Reset condition value to false, so we can wait for new events to be
-        // added that might meet our current filter
-        m_cond_wait.SetValue (false, eBroadcastNever);
+        EventWaiter waiter (broadcaster, broadcaster_names, num_broadcaster_names, event_type_mask);
+
+        // Scope for "locker"
+        {
+            Mutex::Locker locker(m_events_mutex);
+
+            // An event we want might have been added since we looked
+            if (FindNextEventLocked (broadcaster, broadcaster_names, num_broadcaster_names, event_type_mask) != m_events.end())
+                continue;
+
+            // Wait until AddEvent adds an event that matches our filter
+            m_waiters.push_back (&waiter);
+            while (!waiter.signaled && !timed_out)
+            {
+                if (waiter.condition.Wait (m_events_mutex.GetMutex(), timeout, &timed_out) != 0 && !timed_out)
+                    break;
+            }
+            m_waiters.remove (&waiter);
+        }
 
-        if (m_cond_wait.WaitForValueEqualTo (true, timeout, &timed_out))
+        if (waiter.signaled)
             continue;
 
         else if (timed_out)
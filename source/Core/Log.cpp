@@ -9,6 +9,7 @@
 
 // C Includes
 #include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
@@ -25,6 +26,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Host/Condition.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
 #include "lldb/Host/Mutex.h"
@@ -32,6 +34,230 @@
 using namespace lldb;
 using namespace lldb_private;
 
+namespace {
+
+//----------------------------------------------------------------------
+// Everything needed to produce one log line. The header fields are
+// captured when the line is logged, but only turned into text when the
+// line is written, which for asynchronous logs happens on the log
+// writer thread.
+//----------------------------------------------------------------------
+struct LogRecord
+{
+    LogRecord () :
+        options (0),
+        sequence_id (0),
+        pid (LLDB_INVALID_PROCESS_ID),
+        tid (LLDB_INVALID_THREAD_ID),
+        thread_name (),
+        message ()
+    {
+        timestamp.tv_sec = 0;
+        timestamp.tv_usec = 0;
+    }
+
+    void
+    Clear ()
+    {
+        thread_name.clear();
+        message.clear();
+    }
+
+    void
+    Write (Stream &stream) const
+    {
+        StreamString line;
+
+        if (options & LLDB_LOG_OPTION_PREPEND_SEQUENCE)
+            line.Printf ("%u ", sequence_id);
+
+        if (options & LLDB_LOG_OPTION_PREPEND_TIMESTAMP)
+            line.Printf ("%9llu.%6.6llu ", (uint64_t)timestamp.tv_sec, (uint64_t)timestamp.tv_usec);
+
+        if (options & LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD)
+            line.Printf ("[%4.4x/%4.4x]: ", pid, tid);
+
+        if (!thread_name.empty())
+            line.Printf ("%s ", thread_name.c_str());
+
+        line.Write (message.data(), message.size());
+        stream.Printf ("%s\n", line.GetData());
+    }
+
+    uint32_t options;
+    uint32_t sequence_id;
+    struct timeval timestamp;
+    lldb::pid_t pid;
+    lldb::tid_t tid;
+    std::string thread_name;
+    std::string message;
+};
+
+//----------------------------------------------------------------------
+// Writes the lines of all asynchronous logs on a background thread.
+//
+// Logging threads hand records over through a bounded ring buffer that
+// any number of threads can add to without taking a lock: each slot
+// has a sequence number that says whether it is free for the producer
+// that claimed its position, or full and ready for the writer. A
+// producer only takes the mutex to wake the writer when the writer is
+// asleep, and only waits when the buffer is full.
+//----------------------------------------------------------------------
+class AsyncLogWriter
+{
+public:
+    AsyncLogWriter () :
+        m_enqueue_pos (0),
+        m_dequeue_pos (0),
+        m_writer_sleeping (0),
+        m_mutex (Mutex::eMutexTypeNormal),
+        m_condition (),
+        m_thread (LLDB_INVALID_HOST_THREAD)
+    {
+        for (uint32_t i = 0; i < kNumSlots; ++i)
+            m_slots[i].sequence = i;
+        m_thread = Host::ThreadCreate ("<lldb.log.writer>", WriterThread, this, NULL);
+    }
+
+    void
+    Push (const StreamSP &stream_sp, LogRecord &record)
+    {
+        uint32_t pos = m_enqueue_pos;
+        Slot *slot;
+        while (1)
+        {
+            slot = &m_slots[pos & (kNumSlots - 1)];
+            __sync_synchronize();
+            const int32_t diff = (int32_t)(slot->sequence - pos);
+            if (diff == 0)
+            {
+                // The slot is free; claim it
+                if (__sync_bool_compare_and_swap (&m_enqueue_pos, pos, pos + 1))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // The buffer is full; let the writer catch up
+                WakeWriter ();
+                ::sched_yield ();
+            }
+            pos = m_enqueue_pos;
+        }
+
+        slot->stream_sp = stream_sp;
+        std::swap (slot->record, record);
+        __sync_synchronize();
+        slot->sequence = pos + 1;
+
+        __sync_synchronize();
+        if (m_writer_sleeping)
+            WakeWriter ();
+    }
+
+    // Wait until every record that was pushed before this call has been
+    // written.
+    void
+    Flush ()
+    {
+        const uint32_t flush_pos = m_enqueue_pos;
+        while ((int32_t)(m_dequeue_pos - flush_pos) < 0)
+        {
+            WakeWriter ();
+            ::usleep (100);
+        }
+    }
+
+private:
+    enum { kNumSlots = 4096 };  // Must be a power of two
+
+    struct Slot
+    {
+        volatile uint32_t sequence;
+        StreamSP stream_sp;
+        LogRecord record;
+    };
+
+    void
+    WakeWriter ()
+    {
+        Mutex::Locker locker (m_mutex);
+        m_condition.Signal();
+    }
+
+    // Write the oldest record, if there is one
+    bool
+    WriteNextRecord ()
+    {
+        Slot &slot = m_slots[m_dequeue_pos & (kNumSlots - 1)];
+        __sync_synchronize();
+        if (slot.sequence != m_dequeue_pos + 1)
+            return false;
+
+        if (slot.stream_sp)
+        {
+            slot.record.Write (*slot.stream_sp);
+            slot.stream_sp.reset();
+        }
+        slot.record.Clear();
+
+        __sync_synchronize();
+        slot.sequence = m_dequeue_pos + kNumSlots;
+        m_dequeue_pos = m_dequeue_pos + 1;
+        return true;
+    }
+
+    static lldb::thread_result_t
+    WriterThread (lldb::thread_arg_t arg)
+    {
+        AsyncLogWriter *writer = (AsyncLogWriter *)arg;
+        while (1)
+        {
+            while (writer->WriteNextRecord ())
+                ;
+
+            // Producers check m_writer_sleeping after they publish a
+            // record, and we check for records after setting it, so one
+            // of us will always see the other.
+            Mutex::Locker locker (writer->m_mutex);
+            writer->m_writer_sleeping = 1;
+            __sync_synchronize();
+            const Slot &slot = writer->m_slots[writer->m_dequeue_pos & (kNumSlots - 1)];
+            if (slot.sequence != writer->m_dequeue_pos + 1)
+            {
+                TimeValue timeout (TimeValue::Now());
+                timeout.OffsetWithMicroSeconds (100000);
+                writer->m_condition.Wait (writer->m_mutex.GetMutex(), &timeout, NULL);
+            }
+            writer->m_writer_sleeping = 0;
+        }
+        return NULL;
+    }
+
+    Slot m_slots[kNumSlots];
+    volatile uint32_t m_enqueue_pos;     // The next position producers will claim
+    volatile uint32_t m_dequeue_pos;     // The next position the writer will write
+    volatile uint32_t m_writer_sleeping; // Non-zero while the writer waits for records
+    Mutex m_mutex;
+    Condition m_condition;
+    lldb::thread_t m_thread;
+};
+
+}
+
+static AsyncLogWriter *g_async_log_writer = NULL;
+
+static AsyncLogWriter &
+GetAsyncLogWriter ()
+{
+    // The writer thread runs until the process exits, so the writer is
+    // never destroyed.
+    static Mutex g_async_log_writer_mutex (Mutex::eMutexTypeNormal);
+    Mutex::Locker locker (g_async_log_writer_mutex);
+    if (g_async_log_writer == NULL)
+        g_async_log_writer = new AsyncLogWriter ();
+    return *g_async_log_writer;
+}
+
 Log::Log () :
     m_stream_sp(),
     m_options(0),
@@ -48,6 +274,10 @@ Log::Log (StreamSP &stream_sp) :
 
 Log::~Log ()
 {
+    // Lines that are still queued keep the stream alive, but make sure
+    // they are written before anyone looks at it.
+    if (m_options.Test (LLDB_LOG_OPTION_ASYNC) && g_async_log_writer)
+        g_async_log_writer->Flush ();
 }
 
 Flags &
@@ -86,38 +316,51 @@ Log::PrintfWithFlagsVarArg (uint32_t flags, const char *format, va_list args)
     if (m_stream_sp)
     {
         static uint32_t g_sequence_id = 0;
-        StreamString header;
+        LogRecord record;
 		// Enabling the thread safe logging actually deadlocks right now.
 		// Need to fix this at some point.
 //        static Mutex g_LogThreadedMutex(Mutex::eMutexTypeRecursive);
 //        Mutex::Locker locker (g_LogThreadedMutex);
 
+        record.options = m_options.Get();
+
         // Add a sequence ID if requested
         if (m_options.Test (LLDB_LOG_OPTION_PREPEND_SEQUENCE))
-            header.Printf ("%u ", ++g_sequence_id);
+            record.sequence_id = __sync_add_and_fetch (&g_sequence_id, 1);
 
         // Timestamp if requested
         if (m_options.Test (LLDB_LOG_OPTION_PREPEND_TIMESTAMP))
-        {
-            struct timeval tv = TimeValue::Now().GetAsTimeVal();
-            header.Printf ("%9llu.%6.6llu ", tv.tv_sec, tv.tv_usec);
-        }
+            record.timestamp = TimeValue::Now().GetAsTimeVal();
 
         // Add the process and thread if requested
         if (m_options.Test (LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD))
-            header.Printf ("[%4.4x/%4.4x]: ", getpid(), Host::GetCurrentThreadID());
+        {
+            record.pid = getpid();
+            record.tid = Host::GetCurrentThreadID();
+        }
 
-        // Add the process and thread if requested
+        // Add the thread name if requested
         if (m_options.Test (LLDB_LOG_OPTION_PREPEND_THREAD_NAME))
         {
             const char *thread_name_str = Host::GetThreadName (getpid(), Host::GetCurrentThreadID());
             if (thread_name_str)
-                header.Printf ("%s ", thread_name_str);
+                record.thread_name = thread_name_str;
+        }
 
+        char *message = NULL;
+        ::vasprintf (&message, format, args);
+        if (message)
+        {
+            record.message = message;
+            ::free (message);
         }
 
-        header.PrintfVarArg (format, args);
-        m_stream_sp->Printf("%s\n", header.GetData());
+        // Asynchronous logs leave the formatting of the header and the
+        // writing to the stream to the log writer thread.
+        if (m_options.Test (LLDB_LOG_OPTION_ASYNC))
+            GetAsyncLogWriter().Push (m_stream_sp, record);
+        else
+            record.Write (*m_stream_sp);
     }
 }
 
@@ -408,6 +651,8 @@ void
 Log::Terminate ()
 {
     DisableAllLogChannels (NULL);
+    if (g_async_log_writer)
+        g_async_log_writer->Flush ();
 }
 
 void
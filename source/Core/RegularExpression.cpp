@@ -19,7 +19,9 @@ RegularExpression::RegularExpression() :
     m_re(),
     m_comp_err (1),
     m_preg(),
-    m_matches()
+    m_matches(),
+    m_required_literal(),
+    m_required_literal_is_prefix (false)
 {
     memset(&m_preg,0,sizeof(m_preg));
 }
@@ -31,7 +33,10 @@ RegularExpression::RegularExpression() :
 RegularExpression::RegularExpression(const char* re, int flags) :
     m_re(),
     m_comp_err (1),
-    m_preg()
+    m_preg(),
+    m_matches(),
+    m_required_literal(),
+    m_required_literal_is_prefix (false)
 {
     memset(&m_preg,0,sizeof(m_preg));
     Compile(re, flags);
@@ -48,6 +53,174 @@ RegularExpression::~RegularExpression()
     Free();
 }
 
+//----------------------------------------------------------------------
+// Find the longest run of literal characters that every match of the
+// extended regular expression "re" must contain. This is conservative:
+// any construct we don't fully understand ends the current run, and
+// patterns with alternation have no required literal at all. If the
+// literal run is anchored to the start of the pattern, "is_prefix" is
+// set to true.
+//----------------------------------------------------------------------
+static void
+GetRequiredLiteral (const char *re, std::string &literal, bool &is_prefix)
+{
+    literal.clear();
+    is_prefix = false;
+
+    // Any alternation could make every literal optional
+    for (const char *p = re; *p; ++p)
+    {
+        if (*p == '\\' && p[1])
+            ++p;
+        else if (*p == '|')
+            return;
+    }
+
+    std::string run;
+    bool run_is_prefix = false;
+    bool last_was_literal = false;
+    const char *p = re;
+    if (*p == '^')
+    {
+        run_is_prefix = true;
+        ++p;
+    }
+
+    while (1)
+    {
+        const char ch = *p;
+        bool end_run = false;
+        bool append_literal = false;
+        char literal_ch = ch;
+
+        switch (ch)
+        {
+        case '\0':
+            end_run = true;
+            break;
+
+        case '*':
+        case '?':
+        case '{':
+            // The previous atom is optional
+            if (last_was_literal && !run.empty())
+                run.erase (run.size() - 1);
+            if (ch == '{')
+            {
+                while (p[1] && p[1] != '}')
+                    ++p;
+                if (p[1])
+                    ++p;
+            }
+            end_run = true;
+            break;
+
+        case '+':
+            // The previous atom is required but can repeat
+            end_run = true;
+            break;
+
+        case '[':
+            // Skip the bracket expression
+            ++p;
+            if (*p == '^')
+                ++p;
+            if (*p == ']')
+                ++p;
+            while (*p && *p != ']')
+            {
+                if (*p == '[' && (p[1] == ':' || p[1] == '.' || p[1] == '='))
+                {
+                    const char delim = p[1];
+                    p += 2;
+                    while (*p && !(*p == delim && p[1] == ']'))
+                        ++p;
+                    if (*p)
+                        ++p;
+                }
+                if (*p)
+                    ++p;
+            }
+            if (*p == '\0')
+                --p;
+            end_run = true;
+            break;
+
+        case '(':
+            {
+                // Skip the group, it might be optional
+                int depth = 1;
+                while (p[1] && depth > 0)
+                {
+                    ++p;
+                    if (*p == '\\' && p[1])
+                        ++p;
+                    else if (*p == '(')
+                        ++depth;
+                    else if (*p == ')')
+                        --depth;
+                }
+                end_run = true;
+            }
+            break;
+
+        case '\\':
+            if (p[1] && ::strchr (".[]()*+?{}|^$\\", p[1]))
+            {
+                ++p;
+                literal_ch = *p;
+                append_literal = true;
+            }
+            else
+            {
+                if (p[1])
+                    ++p;
+                end_run = true;
+            }
+            break;
+
+        case '.':
+        case '^':
+        case '$':
+        case ')':
+        case ']':
+        case '}':
+            end_run = true;
+            break;
+
+        default:
+            append_literal = true;
+            break;
+        }
+
+        if (append_literal)
+        {
+            // A literal followed by an optional quantifier gets removed
+            // when we see the quantifier
+            run.push_back (literal_ch);
+            last_was_literal = true;
+        }
+        else
+        {
+            last_was_literal = false;
+        }
+
+        if (end_run)
+        {
+            if (run.size() > literal.size())
+            {
+                literal = run;
+                is_prefix = run_is_prefix;
+            }
+            run.clear();
+            run_is_prefix = false;
+            if (ch == '\0')
+                break;
+        }
+        ++p;
+    }
+}
+
 //----------------------------------------------------------------------
 // Compile a regular expression using the supplied regular
 // expression text and flags. The compied regular expression lives
@@ -64,10 +237,21 @@ bool
 RegularExpression::Compile(const char* re, int flags)
 {
     Free();
+    m_required_literal.clear();
+    m_required_literal_is_prefix = false;
     if (re && re[0])
     {
         m_re = re;
         m_comp_err = ::regcomp (&m_preg, re, flags);
+
+        // We can only reason about case sensitive extended regular
+        // expressions
+        if (m_comp_err == 0 && (flags & REG_EXTENDED) && !(flags & REG_ICASE))
+        {
+            GetRequiredLiteral (re, m_required_literal, m_required_literal_is_prefix);
+            if (flags & REG_NEWLINE)
+                m_required_literal_is_prefix = false;
+        }
     }
     else
     {
@@ -78,6 +262,73 @@ RegularExpression::Compile(const char* re, int flags)
     return m_comp_err == 0;
 }
 
+//----------------------------------------------------------------------
+// Convert a shell style wildcard pattern into an anchored extended
+// regular expression and compile it.
+//----------------------------------------------------------------------
+bool
+RegularExpression::CompileGlob (const char* glob, bool allow_argument_list)
+{
+    if (glob == NULL || glob[0] == '\0')
+        return Compile (glob);
+
+    std::string re ("^");
+    for (const char *p = glob; *p; ++p)
+    {
+        switch (*p)
+        {
+        case '*':
+            re.append (".*");
+            break;
+
+        case '?':
+            re.push_back ('.');
+            break;
+
+        case '[':
+            {
+                // Copy the set of characters if it is terminated
+                const char *set_end = p + 1;
+                if (*set_end == '!' || *set_end == '^')
+                    ++set_end;
+                if (*set_end == ']')
+                    ++set_end;
+                set_end = ::strchr (set_end, ']');
+                if (set_end)
+                {
+                    re.push_back ('[');
+                    ++p;
+                    if (*p == '!')
+                    {
+                        re.push_back ('^');
+                        ++p;
+                    }
+                    re.append (p, set_end + 1 - p);
+                    p = set_end;
+                }
+                else
+                    re.append ("\\[");
+            }
+            break;
+
+        case '\\':
+            if (p[1])
+                ++p;
+            // Fall through to escape the next character if needed
+        default:
+            if (::strchr (".[]()*+?{}|^$\\", *p))
+                re.push_back ('\\');
+            re.push_back (*p);
+            break;
+        }
+    }
+    // An optional group doesn't change the required prefix
+    if (allow_argument_list)
+        re.append ("(\\(.*)?");
+    re.push_back ('$');
+    return Compile (re.c_str());
+}
+
 //----------------------------------------------------------------------
 // Execute a regular expression match using the compiled regular
 // expression that is already in this object against the match
@@ -92,6 +343,20 @@ RegularExpression::Execute(const char* s, size_t num_matches, int execute_flags)
     int match_result = 1;
     if (m_comp_err == 0)
     {
+        // Most strings we are asked to match (like all of the symbol
+        // names in a module) don't contain the literal text in the
+        // regular expression, so check for that before running it
+        if (!m_required_literal.empty() && s)
+        {
+            if (m_required_literal_is_prefix)
+            {
+                if (::strncmp (s, m_required_literal.c_str(), m_required_literal.size()) != 0)
+                    return false;
+            }
+            else if (::strstr (s, m_required_literal.c_str()) == NULL)
+                return false;
+        }
+
         if (num_matches > 0)
             m_matches.resize(num_matches + 1);
         else
@@ -138,6 +403,18 @@ RegularExpression::IsValid () const
     return m_comp_err == 0;
 }
 
+//----------------------------------------------------------------------
+// Returns the literal text every match must start with, or NULL if
+// there isn't any.
+//----------------------------------------------------------------------
+const char*
+RegularExpression::GetRequiredPrefix () const
+{
+    if (m_comp_err == 0 && m_required_literal_is_prefix && !m_required_literal.empty())
+        return m_required_literal.c_str();
+    return NULL;
+}
+
 //----------------------------------------------------------------------
 // Returns the text that was used to compile the current regular
 // expression.
@@ -366,7 +366,9 @@ Section::ReadSectionDataFromObjectFile(const ObjectFile* objfile, DataExtractor&
 }
 
 size_t
-Section::MemoryMapSectionDataFromObjectFile(const ObjectFile* objfile, DataExtractor& section_data) const
+Section::MemoryMapSectionDataFromObjectFile(const ObjectFile* objfile, 
+                                            DataExtractor& section_data,
+                                            DataBufferMemoryMap::AccessPattern access_pattern) const
 {
     if (objfile == NULL)
         return 0;
@@ -380,6 +382,10 @@ Section::MemoryMapSectionDataFromObjectFile(const ObjectFile* objfile, DataExtra
         {
             off_t section_file_offset = GetFileOffset() + objfile->GetOffset();
             DataBufferSP section_data_sp(file.MemoryMapFileContents(section_file_offset, section_file_size));
+            // FileSpec::MemoryMapFileContents() only ever hands out memory
+            // mapped buffers
+            if (section_data_sp.get() && access_pattern != DataBufferMemoryMap::eAccessPatternNormal)
+                static_cast<DataBufferMemoryMap *>(section_data_sp.get())->SetAccessPattern (access_pattern);
             section_data.SetByteOrder(objfile->GetByteOrder());
             section_data.SetAddressByteSize(objfile->GetAddressByteSize());
             return section_data.SetData (section_data_sp);
@@ -13,52 +13,172 @@
 #include <algorithm>
 
 #include "lldb/Core/Stream.h"
+#include "lldb/Host/Host.h"
 #include "lldb/Host/Mutex.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined (__APPLE__)
+#include <mach/mach_time.h>
+#endif
 
 using namespace lldb_private;
 
 #define TIMER_INDENT_AMOUNT 2
 static bool g_quiet = true;
-uint32_t Timer::g_depth = 0;
+static bool g_trace_enabled = false;
+static uint64_t g_trace_start = 0;
 uint32_t Timer::g_display_depth = 0;
 FILE * Timer::g_file = NULL;
 typedef std::vector<Timer *> TimerStack;
-typedef std::map<const char *, uint64_t> CategoryMap;
 static pthread_key_t g_key;
 
+namespace {
+
+// The exclusive time of every timer that ran in one category
+struct CategoryStats
+{
+    CategoryStats () :
+        count (0),
+        total (0),
+        min (UINT64_MAX),
+        max (0)
+    {
+    }
+
+    void
+    Add (uint64_t nsec)
+    {
+        ++count;
+        total += nsec;
+        if (nsec < min)
+            min = nsec;
+        if (nsec > max)
+            max = nsec;
+    }
+
+    void
+    Merge (const CategoryStats &rhs)
+    {
+        count += rhs.count;
+        total += rhs.total;
+        if (rhs.min < min)
+            min = rhs.min;
+        if (rhs.max > max)
+            max = rhs.max;
+    }
+
+    uint64_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+};
+
+// One completed timer in the trace timeline
+struct TraceEvent
+{
+    const char *category;
+    std::string name;
+    uint64_t start;
+    uint64_t duration;
+    lldb::tid_t tid;
+};
+
+}
+
+typedef std::map<const char *, CategoryStats> CategoryMap;
+typedef std::vector<TraceEvent> TraceEventList;
+
+namespace {
+
+// Everything the timers on one thread keep track of. Only the owning
+// thread touches "depth" and "stack". The owning thread also updates
+// "categories" and "events", and other threads only read them while
+// dumping, so "mutex" is almost never contended.
+struct ThreadTimerData
+{
+    ThreadTimerData () :
+        mutex (Mutex::eMutexTypeNormal),
+        tid (Host::GetCurrentThreadID()),
+        depth (0),
+        stack (),
+        categories (),
+        events ()
+    {
+    }
+
+    Mutex mutex;
+    lldb::tid_t tid;
+    uint32_t depth;
+    TimerStack stack;
+    CategoryMap categories;
+    TraceEventList events;
+};
+
+}
+
+typedef std::vector<ThreadTimerData *> ThreadDataList;
+
+// Protects the list of live thread data and the retired thread data
 static Mutex &
-GetCategoryMutex()
+GetThreadDataMutex()
 {
-    static Mutex g_category_mutex(Mutex::eMutexTypeNormal);
-    return g_category_mutex;
+    static Mutex g_thread_data_mutex(Mutex::eMutexTypeNormal);
+    return g_thread_data_mutex;
 }
 
-static CategoryMap &
-GetCategoryMap()
+static ThreadDataList &
+GetThreadDataList()
 {
-    static CategoryMap g_category_map;
-    return g_category_map;
+    static ThreadDataList g_thread_data_list;
+    return g_thread_data_list;
 }
 
+// The statistics and events of threads that have exited
+static ThreadTimerData &
+GetRetiredThreadData()
+{
+    static ThreadTimerData g_retired_thread_data;
+    return g_retired_thread_data;
+}
 
-static TimerStack *
-GetTimerStackForCurrentThread ()
+static ThreadTimerData *
+GetTimerDataForCurrentThread ()
 {
-    void *timer_stack = ::pthread_getspecific (g_key);
-    if (timer_stack == NULL)
+    void *thread_data = ::pthread_getspecific (g_key);
+    if (thread_data == NULL)
     {
-        ::pthread_setspecific (g_key, new TimerStack);
-        timer_stack = ::pthread_getspecific (g_key);
+        ThreadTimerData *new_thread_data = new ThreadTimerData;
+        ::pthread_setspecific (g_key, new_thread_data);
+
+        Mutex::Locker locker (GetThreadDataMutex());
+        GetThreadDataList().push_back (new_thread_data);
+        thread_data = new_thread_data;
     }
-    return (TimerStack *)timer_stack;
+    return (ThreadTimerData *)thread_data;
 }
 
 void
 ThreadSpecificCleanup (void *p)
 {
-    delete (TimerStack *)p;
+    ThreadTimerData *thread_data = (ThreadTimerData *)p;
+
+    Mutex::Locker locker (GetThreadDataMutex());
+    ThreadDataList &thread_data_list = GetThreadDataList();
+    ThreadDataList::iterator pos = std::find (thread_data_list.begin(), thread_data_list.end(), thread_data);
+    if (pos != thread_data_list.end())
+        thread_data_list.erase (pos);
+
+    // Keep the results of the exiting thread around for the next dump
+    ThreadTimerData &retired = GetRetiredThreadData();
+    CategoryMap::const_iterator cat_pos, cat_end = thread_data->categories.end();
+    for (cat_pos = thread_data->categories.begin(); cat_pos != cat_end; ++cat_pos)
+        retired.categories[cat_pos->first].Merge (cat_pos->second);
+    retired.events.insert (retired.events.end(), thread_data->events.begin(), thread_data->events.end());
+
+    delete thread_data;
 }
 
 void
@@ -75,91 +195,129 @@ Timer::Initialize ()
 
 }
 
+uint64_t
+Timer::GetMonotonicNanoSeconds ()
+{
+#if defined (__APPLE__)
+    static mach_timebase_info_data_t g_timebase = { 0, 0 };
+    if (g_timebase.denom == 0)
+        ::mach_timebase_info (&g_timebase);
+    return ::mach_absolute_time() * g_timebase.numer / g_timebase.denom;
+#else
+    struct timespec ts;
+    ::clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
 Timer::Timer (const char *category, const char *format, ...) :
     m_category (category),
-    m_total_start (),
-    m_timer_start (),
+    m_name (),
+    m_start (0),
+    m_total_start (0),
+    m_timer_start (0),
     m_total_ticks (0),
     m_timer_ticks (0)
 {
-    if (g_depth++ < g_display_depth)
+    ThreadTimerData *thread_data = GetTimerDataForCurrentThread ();
+    // Timers below the display depth are still timed while tracing so
+    // the trace doesn't depend on "log timers enable"
+    const bool display = thread_data->depth++ < g_display_depth;
+    if (display || g_trace_enabled)
     {
-        if (g_quiet == false)
+        const bool print = display && g_quiet == false;
+        if (print || g_trace_enabled)
         {
-            // Indent
-            ::fprintf (g_file, "%*s", g_depth * TIMER_INDENT_AMOUNT, "");
-            // Print formatted string
+            // Format the description only when somebody will see it
+            char *name = NULL;
             va_list args;
             va_start (args, format);
-            ::vfprintf (g_file, format, args);
+            ::vasprintf (&name, format, args);
             va_end (args);
 
-            // Newline
-            ::fprintf (g_file, "\n");
+            if (name)
+            {
+                if (print)
+                {
+                    // Indent, print the description and a newline
+                    ::fprintf (g_file, "%*s%s\n", thread_data->depth * TIMER_INDENT_AMOUNT, "", name);
+                }
+                if (g_trace_enabled)
+                    m_name = name;
+                ::free (name);
+            }
         }
-        TimeValue start_time(TimeValue::Now());
+        const uint64_t start_time = GetMonotonicNanoSeconds();
+        m_start = start_time;
         m_total_start = start_time;
         m_timer_start = start_time;
-        TimerStack *stack = GetTimerStackForCurrentThread ();
-        if (stack)
-        {
-            if (stack->empty() == false)
-                stack->back()->ChildStarted (start_time);
-            stack->push_back(this);
-        }
+        TimerStack &stack = thread_data->stack;
+        if (stack.empty() == false)
+            stack.back()->ChildStarted (start_time);
+        stack.push_back(this);
     }
 }
 
 
 Timer::~Timer()
 {
-    if (m_total_start.IsValid())
+    ThreadTimerData *thread_data = GetTimerDataForCurrentThread ();
+    if (m_start != 0)
     {
-        TimeValue stop_time = TimeValue::Now();
-        bool notify = false;
-        if (m_total_start.IsValid())
+        // The depth hasn't been popped yet, so this matches the check
+        // in the constructor
+        const bool display = thread_data->depth <= g_display_depth;
+        const uint64_t stop_time = GetMonotonicNanoSeconds();
+        if (m_total_start != 0)
         {
             m_total_ticks += (stop_time - m_total_start);
-            m_total_start.Clear();
-            notify = true;
+            m_total_start = 0;
         }
-        if (m_timer_start.IsValid())
+        if (m_timer_start != 0)
         {
             m_timer_ticks += (stop_time - m_timer_start);
-            m_timer_start.Clear();
+            m_timer_start = 0;
         }
 
-        TimerStack *stack = GetTimerStackForCurrentThread ();
-        if (stack)
-        {
-            assert (stack->back() == this);
-            stack->pop_back();
-            if (stack->empty() == false)
-                stack->back()->ChildStopped(stop_time);
-        }
+        TimerStack &stack = thread_data->stack;
+        assert (stack.empty() == false && stack.back() == this);
+        stack.pop_back();
+        if (stack.empty() == false)
+            stack.back()->ChildStopped(stop_time);
 
         const uint64_t total_nsec_uint = GetTotalElapsedNanoSeconds();
         const uint64_t timer_nsec_uint = GetTimerElapsedNanoSeconds();
         const double total_nsec = total_nsec_uint;
         const double timer_nsec = timer_nsec_uint;
 
-        if (g_quiet == false)
+        if (display && g_quiet == false)
         {
 
             ::fprintf (g_file,
                        "%*s%.9f sec (%.9f sec)\n",
-                       (g_depth - 1) *TIMER_INDENT_AMOUNT, "",
+                       (thread_data->depth - 1) *TIMER_INDENT_AMOUNT, "",
                        total_nsec / 1000000000.0,
                        timer_nsec / 1000000000.0);
         }
 
-        // Keep total results for each category so we can dump results.
-        Mutex::Locker locker (GetCategoryMutex());
-        CategoryMap &category_map = GetCategoryMap();
-        category_map[m_category] += timer_nsec_uint;
+        // Keep results for each category so we can dump them, and the
+        // timer itself if we are recording a trace.
+        Mutex::Locker locker (thread_data->mutex);
+        if (display)
+            thread_data->categories[m_category].Add (timer_nsec_uint);
+        if (g_trace_enabled)
+        {
+            TraceEvent event;
+            event.category = m_category;
+            event.name = m_name.empty() ? m_category : m_name;
+            event.start = m_start;
+            event.duration = total_nsec_uint;
+            event.tid = thread_data->tid;
+            thread_data->events.push_back (event);
+        }
     }
-    if (g_depth > 0)
-        --g_depth;
+    if (thread_data->depth > 0)
+        --thread_data->depth;
 }
 
 uint64_t
@@ -169,8 +327,8 @@ Timer::GetTotalElapsedNanoSeconds()
 
     // If we are currently running, we need to add the current
     // elapsed time of the running timer...
-    if (m_total_start.IsValid())
-        total_ticks += (TimeValue::Now() - m_total_start);
+    if (m_total_start != 0)
+        total_ticks += (GetMonotonicNanoSeconds() - m_total_start);
 
     return total_ticks;
 }
@@ -182,26 +340,26 @@ Timer::GetTimerElapsedNanoSeconds()
 
     // If we are currently running, we need to add the current
     // elapsed time of the running timer...
-    if (m_timer_start.IsValid())
-        timer_ticks += (TimeValue::Now() - m_timer_start);
+    if (m_timer_start != 0)
+        timer_ticks += (GetMonotonicNanoSeconds() - m_timer_start);
 
     return timer_ticks;
 }
 
 void
-Timer::ChildStarted (const TimeValue& start_time)
+Timer::ChildStarted (uint64_t start_time)
 {
-    if (m_timer_start.IsValid())
+    if (m_timer_start != 0)
     {
         m_timer_ticks += (start_time - m_timer_start);
-        m_timer_start.Clear();
+        m_timer_start = 0;
     }
 }
 
 void
-Timer::ChildStopped (const TimeValue& stop_time)
+Timer::ChildStopped (uint64_t stop_time)
 {
-    if (!m_timer_start.IsValid())
+    if (m_timer_start == 0)
         m_timer_start = stop_time;
 }
 
@@ -213,28 +371,50 @@ Timer::SetDisplayDepth (uint32_t depth)
 
 
 /* binary function predicate:
- * - returns whether a person is less than another person
+ * - returns whether a category took more time than another category
  */
 static bool
 CategoryMapIteratorSortCriterion (const CategoryMap::const_iterator& lhs, const CategoryMap::const_iterator& rhs)
 {
-    return lhs->second > rhs->second;
+    return lhs->second.total > rhs->second.total;
 }
 
 
 void
 Timer::ResetCategoryTimes ()
 {
-    Mutex::Locker locker (GetCategoryMutex());
-    CategoryMap &category_map = GetCategoryMap();
-    category_map.clear();
+    Mutex::Locker locker (GetThreadDataMutex());
+    GetRetiredThreadData().categories.clear();
+
+    ThreadDataList &thread_data_list = GetThreadDataList();
+    ThreadDataList::iterator pos, end = thread_data_list.end();
+    for (pos = thread_data_list.begin(); pos != end; ++pos)
+    {
+        Mutex::Locker thread_locker ((*pos)->mutex);
+        (*pos)->categories.clear();
+    }
 }
 
 void
 Timer::DumpCategoryTimes (Stream *s)
 {
-    Mutex::Locker locker (GetCategoryMutex());
-    CategoryMap &category_map = GetCategoryMap();
+    // Merge the results from all threads
+    CategoryMap category_map;
+    {
+        Mutex::Locker locker (GetThreadDataMutex());
+        ThreadDataList all_thread_data (GetThreadDataList());
+        all_thread_data.push_back (&GetRetiredThreadData());
+
+        for (size_t i=0; i<all_thread_data.size(); ++i)
+        {
+            ThreadTimerData *thread_data = all_thread_data[i];
+            Mutex::Locker thread_locker (thread_data->mutex);
+            CategoryMap::const_iterator pos, end = thread_data->categories.end();
+            for (pos = thread_data->categories.begin(); pos != end; ++pos)
+                category_map[pos->first].Merge (pos->second);
+        }
+    }
+
     std::vector<CategoryMap::const_iterator> sorted_iterators;
     CategoryMap::const_iterator pos, end = category_map.end();
     for (pos = category_map.begin(); pos != end; ++pos)
@@ -246,7 +426,93 @@ Timer::DumpCategoryTimes (Stream *s)
     const size_t count = sorted_iterators.size();
     for (size_t i=0; i<count; ++i)
     {
-        const double timer_nsec = sorted_iterators[i]->second;
-        s->Printf("%.9f sec for %s\n", timer_nsec / 1000000000.0, sorted_iterators[i]->first);
+        const CategoryStats &stats = sorted_iterators[i]->second;
+        s->Printf("%.9f sec for %s (count = %llu, min = %.9f sec, max = %.9f sec)\n",
+                  (double)stats.total / 1000000000.0,
+                  sorted_iterators[i]->first,
+                  stats.count,
+                  (double)stats.min / 1000000000.0,
+                  (double)stats.max / 1000000000.0);
+    }
+}
+
+void
+Timer::SetTraceEnabled (bool enabled)
+{
+    if (enabled)
+    {
+        Mutex::Locker locker (GetThreadDataMutex());
+        GetRetiredThreadData().events.clear();
+
+        ThreadDataList &thread_data_list = GetThreadDataList();
+        ThreadDataList::iterator pos, end = thread_data_list.end();
+        for (pos = thread_data_list.begin(); pos != end; ++pos)
+        {
+            Mutex::Locker thread_locker ((*pos)->mutex);
+            (*pos)->events.clear();
+        }
+        g_trace_start = GetMonotonicNanoSeconds();
+    }
+    g_trace_enabled = enabled;
+}
+
+bool
+Timer::GetTraceEnabled ()
+{
+    return g_trace_enabled;
+}
+
+static void
+DumpJSONString (Stream *s, const char *str)
+{
+    for (const char *p = str; *p; ++p)
+    {
+        const char ch = *p;
+        if (ch == '"' || ch == '\\')
+            s->Printf("\\%c", ch);
+        else if ((unsigned char)ch < 0x20)
+            s->Printf("\\u%4.4x", ch);
+        else
+            s->PutChar(ch);
+    }
+}
+
+void
+Timer::DumpTrace (Stream *s)
+{
+    TraceEventList events;
+    {
+        Mutex::Locker locker (GetThreadDataMutex());
+        const ThreadTimerData &retired = GetRetiredThreadData();
+        events.insert (events.end(), retired.events.begin(), retired.events.end());
+
+        ThreadDataList &thread_data_list = GetThreadDataList();
+        ThreadDataList::iterator pos, end = thread_data_list.end();
+        for (pos = thread_data_list.begin(); pos != end; ++pos)
+        {
+            Mutex::Locker thread_locker ((*pos)->mutex);
+            events.insert (events.end(), (*pos)->events.begin(), (*pos)->events.end());
+        }
+    }
+
+    // Complete ("X") events with microsecond timestamps relative to when
+    // tracing was enabled
+    const lldb::pid_t pid = Host::GetCurrentProcessID();
+    s->Printf("{\"traceEvents\":[");
+    const size_t count = events.size();
+    for (size_t i=0; i<count; ++i)
+    {
+        const TraceEvent &event = events[i];
+        const uint64_t start = event.start > g_trace_start ? event.start - g_trace_start : 0;
+        s->Printf("%s\n{\"name\":\"", i > 0 ? "," : "");
+        DumpJSONString (s, event.name.c_str());
+        s->Printf("\",\"cat\":\"");
+        DumpJSONString (s, event.category);
+        s->Printf("\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%llu,\"tid\":%llu}",
+                  (double)start / 1000.0,
+                  (double)event.duration / 1000.0,
+                  (uint64_t)pid,
+                  (uint64_t)event.tid);
     }
+    s->Printf("\n]}\n");
 }
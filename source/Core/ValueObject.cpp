@@ -58,6 +58,9 @@ ValueObject::ValueObject (ValueObject *parent) :
     m_location_str (),
     m_summary_str (),
     m_object_desc_str (),
+    m_child_data (),
+    m_child_data_addr (LLDB_INVALID_ADDRESS),
+    m_child_data_value_type (Value::eValueTypeScalar),
     m_children (),
     m_synthetic_children (),
     m_dynamic_value_sp (),
@@ -67,7 +70,8 @@ ValueObject::ValueObject (ValueObject *parent) :
     m_children_count_valid (false),
     m_old_value_valid (false),
     m_pointers_point_to_load_addrs (false),
-    m_is_deref_of_parent (false)
+    m_is_deref_of_parent (false),
+    m_child_data_read_failed (false)
 {
 }
 
@@ -116,6 +120,9 @@ ValueObject::UpdateValueIfNeeded (ExecutionContextScope *exe_scope)
                 m_location_str.clear();
                 m_summary_str.clear();
                 m_object_desc_str.clear();
+                m_child_data.Clear();
+                m_child_data_addr = LLDB_INVALID_ADDRESS;
+                m_child_data_read_failed = false;
 
                 const bool value_was_valid = GetValueIsValid();
                 SetValueDidChange (false);
@@ -157,6 +164,104 @@ ValueObject::GetDataExtractor ()
     return m_data;
 }
 
+// Arrays can be huge, so we never read more than this many bytes of
+// child data at a time.
+static const size_t g_max_child_data_read_size = 0x10000;
+
+bool
+ValueObject::GetChildData (ExecutionContextScope *exe_scope,
+                           const Value &child_value,
+                           uint32_t child_byte_size,
+                           DataExtractor &data)
+{
+    if (child_byte_size == 0)
+        return false;
+
+    const Value::ValueType value_type = child_value.GetValueType();
+    if (value_type != Value::eValueTypeLoadAddress && value_type != Value::eValueTypeHostAddress)
+        return false;
+
+    const lldb::addr_t child_addr = child_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+    if (child_addr == LLDB_INVALID_ADDRESS)
+        return false;
+
+    // Use the memory we already read for our other children if it
+    // contains this child
+    if (m_child_data_addr != LLDB_INVALID_ADDRESS &&
+        m_child_data_value_type == value_type &&
+        child_addr >= m_child_data_addr &&
+        child_addr + child_byte_size <= m_child_data_addr + m_child_data.GetByteSize())
+    {
+        return data.SetData (m_child_data, child_addr - m_child_data_addr, child_byte_size) == child_byte_size;
+    }
+
+    // Don't keep trying to read memory that we already failed to read
+    if (m_child_data_read_failed)
+        return false;
+
+    // Figure out the range of memory that all of our children live in
+    lldb::addr_t region_addr = LLDB_INVALID_ADDRESS;
+    size_t region_size = 0;
+    clang_type_t pointee_type = NULL;
+    if (ClangASTContext::IsPointerOrReferenceType (GetClangType(), &pointee_type))
+    {
+        uint32_t offset = 0;
+        region_addr = m_data.GetPointer (&offset);
+        if (pointee_type)
+            region_size = (ClangASTType::GetClangTypeBitWidth (GetClangAST(), pointee_type) + 7) / 8;
+    }
+    else if (m_value.GetValueType() == value_type)
+    {
+        region_addr = m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+        region_size = GetByteSize();
+    }
+
+    if (region_addr == LLDB_INVALID_ADDRESS || region_addr == 0 || region_size == 0)
+        return false;
+
+    // Synthetic array members of pointers live outside of the pointee
+    if (child_addr < region_addr || child_addr + child_byte_size > region_addr + region_size)
+        return false;
+
+    // Read the whole region if it isn't too big, else read a chunk of it
+    // starting at this child since children are usually asked for in order
+    lldb::addr_t read_addr = region_addr;
+    size_t read_size = region_size;
+    if (read_size > g_max_child_data_read_size)
+    {
+        read_addr = child_addr;
+        read_size = region_addr + region_size - child_addr;
+        if (read_size > g_max_child_data_read_size)
+            read_size = std::max<size_t> (g_max_child_data_read_size, child_byte_size);
+    }
+
+    ExecutionContext exe_ctx (exe_scope);
+    DataBufferSP data_sp (new DataBufferHeap (read_size, '\0'));
+    if (value_type == Value::eValueTypeHostAddress)
+    {
+        ::memcpy (data_sp->GetBytes(), (uint8_t*)NULL + read_addr, read_size);
+        m_child_data.SetByteOrder (lldb::endian::InlHostByteOrder());
+        m_child_data.SetAddressByteSize (sizeof(void *));
+    }
+    else
+    {
+        Error error;
+        if (exe_ctx.process == NULL ||
+            exe_ctx.process->ReadMemory (read_addr, data_sp->GetBytes(), read_size, error) != read_size)
+        {
+            m_child_data_read_failed = true;
+            return false;
+        }
+        m_child_data.SetByteOrder (exe_ctx.process->GetTarget().GetArchitecture().GetByteOrder());
+        m_child_data.SetAddressByteSize (exe_ctx.process->GetTarget().GetArchitecture().GetAddressByteSize());
+    }
+    m_child_data.SetData (data_sp);
+    m_child_data_addr = read_addr;
+    m_child_data_value_type = value_type;
+
+    return data.SetData (m_child_data, child_addr - m_child_data_addr, child_byte_size) == child_byte_size;
+}
+
 const Error &
 ValueObject::GetError() const
 {
@@ -453,65 +558,44 @@ ValueObject::GetSummaryAsCString (ExecutionContextScope *exe_scope)
                             // We have a pointer
                             cstr_address = GetPointerValue (cstr_address_type, true);
                         }
+                        Target *target = exe_scope->CalculateTarget();
+                        const size_t max_length = target ? target->GetMaximumStringSummaryLength() : 1024;
                         if (cstr_address != LLDB_INVALID_ADDRESS)
                         {
-                            DataExtractor data;
-                            size_t bytes_read = 0;
-                            std::vector<char> data_buffer;
+                            std::string cstr;
+                            bool truncated = false;
                             Error error;
                             if (cstr_len > 0)
                             {
-                                data_buffer.resize(cstr_len);
-                                data.SetData (&data_buffer.front(), data_buffer.size(), lldb::endian::InlHostByteOrder());
-                                bytes_read = process->ReadMemory (cstr_address, &data_buffer.front(), cstr_len, error);
-                                if (bytes_read > 0)
+                                if (cstr_len > max_length)
                                 {
-                                    sstr << '"';
-                                    data.Dump (&sstr,
-                                               0,                 // Start offset in "data"
-                                               eFormatChar,       // Print as characters
-                                               1,                 // Size of item (1 byte for a char!)
-                                               bytes_read,        // How many bytes to print?
-                                               UINT32_MAX,        // num per line
-                                               LLDB_INVALID_ADDRESS,// base address
-                                               0,                 // bitfield bit size
-                                               0);                // bitfield bit offset
-                                    sstr << '"';
+                                    cstr_len = max_length;
+                                    truncated = true;
                                 }
+                                cstr.resize (cstr_len);
+                                cstr.resize (process->ReadMemory (cstr_address, &cstr[0], cstr_len, error));
                             }
                             else
                             {
-                                const size_t k_max_buf_size = 256;
-                                data_buffer.resize (k_max_buf_size + 1);
-                                // NULL terminate in case we don't get the entire C string
-                                data_buffer.back() = '\0';
+                                truncated = !process->ReadCStringFromMemory (cstr_address, cstr, max_length, error) && error.Success();
+                            }
 
+                            if (!cstr.empty() || (cstr_len == 0 && error.Success()))
+                            {
+                                DataExtractor data (cstr.data(), cstr.size(), lldb::endian::InlHostByteOrder(), sizeof(void *));
                                 sstr << '"';
-
-                                data.SetData (&data_buffer.front(), data_buffer.size(), endian::InlHostByteOrder());
-                                while ((bytes_read = process->ReadMemory (cstr_address, &data_buffer.front(), k_max_buf_size, error)) > 0)
-                                {
-                                    size_t len = strlen(&data_buffer.front());
-                                    if (len == 0)
-                                        break;
-                                    if (len > bytes_read)
-                                        len = bytes_read;
-
-                                    data.Dump (&sstr,
-                                               0,                 // Start offset in "data"
-                                               eFormatChar,       // Print as characters
-                                               1,                 // Size of item (1 byte for a char!)
-                                               len,               // How many bytes to print?
-                                               UINT32_MAX,        // num per line
-                                               LLDB_INVALID_ADDRESS,// base address
-                                               0,                 // bitfield bit size
-                                               0);                // bitfield bit offset
-                                    
-                                    if (len < k_max_buf_size)
-                                        break;
-                                    cstr_address += k_max_buf_size;
-                                }
+                                data.Dump (&sstr,
+                                           0,                 // Start offset in "data"
+                                           eFormatChar,       // Print as characters
+                                           1,                 // Size of item (1 byte for a char!)
+                                           cstr.size(),       // How many bytes to print?
+                                           UINT32_MAX,        // num per line
+                                           LLDB_INVALID_ADDRESS,// base address
+                                           0,                 // bitfield bit size
+                                           0);                // bitfield bit offset
                                 sstr << '"';
+                                if (truncated)
+                                    sstr << "...";
                             }
                         }
                     }
@@ -568,6 +652,46 @@ ValueObject::GetSummaryAsCString (ExecutionContextScope *exe_scope)
     return m_summary_str.c_str();
 }
 
+// Each child that is a C string reads its own string when its summary is
+// made, so get the memory cache to read the memory for all of them with as
+// few reads as possible first.
+void
+ValueObject::PrefetchChildCStrings (ExecutionContextScope *exe_scope)
+{
+    Process *process = exe_scope ? exe_scope->CalculateProcess() : NULL;
+    if (process == NULL)
+        return;
+
+    const uint32_t num_children = GetNumChildren();
+    if (num_children < 2)
+        return;
+
+    std::vector<lldb::addr_t> cstr_addrs;
+    for (uint32_t idx = 0; idx < num_children; ++idx)
+    {
+        ValueObjectSP child_sp (GetChildAtIndex (idx, true));
+        if (!child_sp)
+            continue;
+
+        clang_type_t pointee_clang_type = NULL;
+        const Flags type_flags (ClangASTContext::GetTypeInfo (child_sp->GetClangType(),
+                                                              child_sp->GetClangAST(),
+                                                              &pointee_clang_type));
+        if (type_flags.Test (ClangASTContext::eTypeIsPointer) &&
+            ClangASTContext::IsCharType (pointee_clang_type) &&
+            child_sp->UpdateValueIfNeeded (exe_scope))
+        {
+            lldb::AddressType cstr_address_type = eAddressTypeInvalid;
+            const lldb::addr_t cstr_address = child_sp->GetPointerValue (cstr_address_type, true);
+            if (cstr_address_type == eAddressTypeLoad && cstr_address != 0 && cstr_address != LLDB_INVALID_ADDRESS)
+                cstr_addrs.push_back (cstr_address);
+        }
+    }
+
+    if (cstr_addrs.size() > 1)
+        process->PrefetchMemory (cstr_addrs);
+}
+
 const char *
 ValueObject::GetObjectDescription (ExecutionContextScope *exe_scope)
 {
@@ -792,6 +916,14 @@ ValueObject::SetValueFromCString (ExecutionContextScope *exe_scope, const char *
 
     case eEncodingIEEE754:
         {
+            // A child's m_data shares its bytes with its parent (see
+            // GetChildData()), so give m_data its own copy before we
+            // change it in place.
+            if (m_data.GetByteSize() > 0)
+            {
+                DataBufferSP data_copy_sp (new DataBufferHeap (m_data.GetDataStart(), m_data.GetByteSize()));
+                m_data.SetData (data_copy_sp);
+            }
             const off_t byte_offset = GetByteOffset();
             uint8_t *dst = const_cast<uint8_t *>(m_data.PeekData(byte_offset, byte_size));
             if (dst != NULL)
@@ -1172,6 +1304,8 @@ ValueObject::DumpValueObject
                             s.IndentMore();
                         }
 
+                        valobj->PrefetchChildCStrings (exe_scope);
+
                         for (uint32_t idx=0; idx<num_children; ++idx)
                         {
                             ValueObjectSP child_sp(valobj->GetChildAtIndex(idx, true));
@@ -168,8 +168,16 @@ ValueObjectChild::UpdateValue (ExecutionContextScope *exe_scope)
 
             if (m_error.Success())
             {
-                ExecutionContext exe_ctx (exe_scope);
-                m_error = m_value.GetValueAsData (&exe_ctx, GetClangAST (), m_data, 0);
+                // Slice our data out of the memory our parent read for all
+                // of its children, and only read it ourselves if we can't
+                const uint32_t value_byte_size = m_value.GetValueByteSize (GetClangAST (), NULL);
+                if (!parent->GetChildData (exe_scope, m_value, value_byte_size, m_data))
+                {
+                    // Don't write into a buffer we share with our parent
+                    m_data.Clear();
+                    ExecutionContext exe_ctx (exe_scope);
+                    m_error = m_value.GetValueAsData (&exe_ctx, GetClangAST (), m_data, 0);
+                }
             }
         }
         else
@@ -856,6 +856,19 @@ ClangExpressionDeclMap::DoMaterialize
                         *result_sp_ptr = member_sp;
                     
                     keep_this_in_memory = m_keep_result_in_memory;
+                    
+                    // Reused code runs again with the same result variable,
+                    // which the last run already read back.  Make this run
+                    // allocate it and read it again.
+                    if (!dematerialize)
+                    {
+                        member_sp->m_flags |= ClangExpressionVariable::EVNeedsFreezeDry;
+                        
+                        if (member_sp->m_flags & ClangExpressionVariable::EVIsLLDBAllocated)
+                            member_sp->m_flags |= ClangExpressionVariable::EVNeedsAllocation;
+                        else if (member_sp->m_flags & ClangExpressionVariable::EVIsProgramReference)
+                            member_sp->m_live_sp.reset();
+                    }
                 }
 
                 if (!DoMaterializeOnePersistentVariable (dematerialize, 
@@ -19,6 +19,7 @@
 #include "lldb/Expression/ClangExpression.h"
 #include "lldb/Expression/IRDynamicChecks.h"
 #include "lldb/Expression/IRForTarget.h"
+#include "lldb/Expression/IRInterpreter.h"
 #include "lldb/Expression/IRToDWARF.h"
 #include "lldb/Expression/RecordingMemoryManager.h"
 #include "lldb/Target/ExecutionContext.h"
@@ -184,7 +185,9 @@ ClangExpressionParser::ClangExpressionParser (ExecutionContextScope *exe_scope,
     m_compiler (),
     m_code_generator (NULL),
     m_execution_engine (),
-    m_jitted_functions ()
+    m_jitted_functions (),
+    m_interpreted_module (),
+    m_interpreter ()
 {
     // Initialize targets first, so that --version shows registered targets.
     static struct InitializeLLVM {
@@ -439,7 +442,8 @@ ClangExpressionParser::MakeJIT (lldb::addr_t &func_allocation_addr,
                                 lldb::addr_t &func_addr, 
                                 lldb::addr_t &func_end, 
                                 ExecutionContext &exe_ctx,
-                                lldb::ClangExpressionVariableSP *const_result)
+                                lldb::ClangExpressionVariableSP *const_result,
+                                bool interpret_if_possible)
 {
     func_allocation_addr = LLDB_INVALID_ADDRESS;
 	func_addr = LLDB_INVALID_ADDRESS;
@@ -495,6 +499,26 @@ ClangExpressionParser::MakeJIT (lldb::addr_t &func_allocation_addr,
             return err;
         }
         
+        // Simple expressions can be run by LLDB without touching the
+        // target.  This must happen before the dynamic checks are added,
+        // since they are calls into the target.
+        if (interpret_if_possible)
+        {
+            std::auto_ptr<IRInterpreter> interpreter(new IRInterpreter(function_name.c_str()));
+            
+            if (interpreter->Prepare(*module, *decl_map, exe_ctx))
+            {
+                if (log)
+                    log->Printf("Code will be interpreted.");
+                
+                m_interpreted_module.reset(module);
+                m_interpreter = interpreter;
+                
+                err.Clear();
+                return err;
+            }
+        }
+        
         if (m_expr.NeedsValidation() && exe_ctx.process->GetDynamicCheckers())
         {
             IRDynamicChecks ir_dynamic_checks(*exe_ctx.process->GetDynamicCheckers(), function_name.c_str());
@@ -28,12 +28,14 @@
 #include "lldb/Expression/ClangExpressionParser.h"
 #include "lldb/Expression/ClangFunction.h"
 #include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Expression/IRInterpreter.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Symbol/VariableList.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadPlan.h"
 #include "lldb/Target/ThreadPlanCallUserExpression.h"
 
@@ -49,7 +51,11 @@ ClangUserExpression::ClangUserExpression (const char *expr,
     m_objectivec (false),
     m_needs_object_ptr (false),
     m_const_object (false),
-    m_desired_type (NULL, NULL)
+    m_desired_type (NULL, NULL),
+    m_interpret_if_possible (false),
+    m_keep_result_in_memory (false),
+    m_can_reuse_parse (false),
+    m_parse_sym_ctx ()
 {
 }
 
@@ -143,6 +149,56 @@ ApplyUnicharHack(std::string &expr)
 #undef UNICHAR_HACK_FROM
 }
 
+static const uint32_t g_parse_sym_ctx_scope = lldb::eSymbolContextModule   |
+                                               lldb::eSymbolContextCompUnit |
+                                               lldb::eSymbolContextFunction |
+                                               lldb::eSymbolContextBlock    |
+                                               lldb::eSymbolContextSymbol;
+
+static void
+GetParseSymbolContext (ExecutionContext &exe_ctx, SymbolContext &sc)
+{
+    if (exe_ctx.frame)
+        sc = exe_ctx.frame->GetSymbolContext (g_parse_sym_ctx_scope);
+    else if (exe_ctx.thread)
+        sc = exe_ctx.thread->GetStackFrameAtIndex(0)->GetSymbolContext (g_parse_sym_ctx_scope);
+    else
+        sc.Clear();
+}
+
+bool
+ClangUserExpression::CanReuseParse (ExecutionContext &exe_ctx,
+                                    TypeFromUser desired_type,
+                                    bool keep_result_in_memory)
+{
+    if (!m_can_reuse_parse || 
+        (m_jit_start_addr == LLDB_INVALID_ADDRESS && !CanInterpret()) ||
+        m_expr_decl_map.get() == NULL)
+        return false;
+    
+    // The code was JITted into, or parsed for, one particular process
+    if (exe_ctx.process == NULL || 
+        m_jit_process_sp.get() != exe_ctx.process || 
+        !exe_ctx.process->IsAlive())
+        return false;
+    
+    if (keep_result_in_memory != m_keep_result_in_memory ||
+        desired_type.GetOpaqueQualType() != m_desired_type.GetOpaqueQualType() ||
+        desired_type.GetASTContext() != m_desired_type.GetASTContext())
+        return false;
+    
+    // The variables the expression refers to, and their types, are the
+    // ones in scope in the block it was parsed in. Materialization looks
+    // them up by name and type again each time the code is run.
+    SymbolContext sc;
+    GetParseSymbolContext (exe_ctx, sc);
+    return sc.module_sp   == m_parse_sym_ctx.module_sp &&
+           sc.comp_unit   == m_parse_sym_ctx.comp_unit &&
+           sc.function    == m_parse_sym_ctx.function &&
+           sc.block       == m_parse_sym_ctx.block &&
+           sc.symbol      == m_parse_sym_ctx.symbol;
+}
+
 bool
 ClangUserExpression::Parse (Stream &error_stream, 
                             ExecutionContext &exe_ctx,
@@ -152,6 +208,26 @@ ClangUserExpression::Parse (Stream &error_stream,
 {
     lldb::LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
     
+    // A constant result is only produced by a full parse
+    if (const_result == NULL && CanReuseParse (exe_ctx, desired_type, keep_result_in_memory))
+    {
+        if (log)
+            log->Printf("Reusing the parsed code for \"%s\"", m_expr_text.c_str());
+        return true;
+    }
+    
+    // Throw away anything left over from a previous parse
+    DeallocateJITFunction ();
+    m_jit_start_addr = LLDB_INVALID_ADDRESS;
+    m_jit_end_addr = LLDB_INVALID_ADDRESS;
+    m_can_reuse_parse = false;
+    m_parse_sym_ctx.Clear();
+    m_parser_ap.reset();
+    m_cplusplus = false;
+    m_objectivec = false;
+    m_needs_object_ptr = false;
+    m_const_object = false;
+    
     ScanContext(exe_ctx);
     
     StreamString m_transformed_stream;
@@ -243,9 +319,9 @@ ClangUserExpression::Parse (Stream &error_stream,
     
     m_expr_decl_map->WillParse(exe_ctx);
     
-    ClangExpressionParser parser(exe_ctx.process, *this);
+    std::auto_ptr<ClangExpressionParser> parser_ap(new ClangExpressionParser(exe_ctx.process, *this));
     
-    unsigned num_errors = parser.Parse (error_stream);
+    unsigned num_errors = parser_ap->Parse (error_stream);
     
     if (num_errors)
     {
@@ -266,7 +342,7 @@ ClangUserExpression::Parse (Stream &error_stream,
     
     m_local_variables.reset(new ClangExpressionVariableList());
             
-    Error dwarf_error = parser.MakeDWARF ();
+    Error dwarf_error = parser_ap->MakeDWARF ();
     
     if (dwarf_error.Success())
     {
@@ -284,14 +360,31 @@ ClangUserExpression::Parse (Stream &error_stream,
     
     m_dwarf_opcodes.reset();
     
-    Error jit_error = parser.MakeJIT (m_jit_alloc, m_jit_start_addr, m_jit_end_addr, exe_ctx, const_result);
+    Error jit_error = parser_ap->MakeJIT (m_jit_alloc, m_jit_start_addr, m_jit_end_addr, exe_ctx, const_result, m_interpret_if_possible);
     
     m_expr_decl_map->DidParse();
     
     if (jit_error.Success())
     {
-        if (exe_ctx.process && m_jit_alloc != LLDB_INVALID_ADDRESS)
+        if (exe_ctx.process && parser_ap->GetInterpreter())
+        {
+            // The parser owns the interpreter
+            m_parser_ap = parser_ap;
+            m_jit_process_sp = exe_ctx.process->GetSP();
+            
+            m_keep_result_in_memory = keep_result_in_memory;
+            GetParseSymbolContext (exe_ctx, m_parse_sym_ctx);
+            m_can_reuse_parse = true;
+        }
+        else if (exe_ctx.process && m_jit_alloc != LLDB_INVALID_ADDRESS)
+        {
             m_jit_process_sp = exe_ctx.process->GetSP();        
+            
+            // Remember where this was parsed so the code can be reused
+            m_keep_result_in_memory = keep_result_in_memory;
+            GetParseSymbolContext (exe_ctx, m_parse_sym_ctx);
+            m_can_reuse_parse = true;
+        }
         return true;
     }
     else
@@ -310,7 +403,7 @@ ClangUserExpression::PrepareToExecuteJITExpression (Stream &error_stream,
 {
     lldb::LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
 
-    if (m_jit_start_addr != LLDB_INVALID_ADDRESS)
+    if (m_jit_start_addr != LLDB_INVALID_ADDRESS || CanInterpret())
     {
         Error materialize_error;
         
@@ -453,6 +546,54 @@ ClangUserExpression::FinalizeJITExecution (Stream &error_stream,
     return true;
 }        
 
+bool
+ClangUserExpression::CanInterpret ()
+{
+    return m_parser_ap.get() && m_parser_ap->GetInterpreter();
+}
+
+bool
+ClangUserExpression::Interpret (Stream &error_stream,
+                                ExecutionContext &exe_ctx,
+                                lldb::ClangExpressionVariableSP &result)
+{
+    lldb::LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+
+    if (!CanInterpret())
+    {
+        error_stream.Printf("Expression can't be interpreted\n");
+        return false;
+    }
+    
+    lldb::addr_t struct_address = LLDB_INVALID_ADDRESS;
+    lldb::addr_t object_ptr = NULL;
+    lldb::addr_t cmd_ptr = NULL;
+    
+    if (!PrepareToExecuteJITExpression (error_stream, exe_ctx, struct_address, object_ptr, cmd_ptr))
+        return false;
+    
+    if (log)
+        log->Printf("-- [ClangUserExpression::Interpret] Interpretation of expression begins --");
+    
+    Error interpret_error;
+    
+    if (!m_parser_ap->GetInterpreter()->Run (exe_ctx, struct_address, object_ptr, cmd_ptr, interpret_error))
+    {
+        error_stream.Printf("Couldn't interpret expression: %s\n", interpret_error.AsCString("unknown error"));
+        
+        // Dematerialize anyway so the argument struct is freed
+        StreamString dematerialize_errors;
+        lldb::ClangExpressionVariableSP ignored_result;
+        FinalizeJITExecution (dematerialize_errors, exe_ctx, ignored_result);
+        return false;
+    }
+    
+    if (log)
+        log->Printf("-- [ClangUserExpression::Interpret] Interpretation of expression completed --");
+    
+    return FinalizeJITExecution (error_stream, exe_ctx, result);
+}
+
 lldb::ExecutionResults
 ClangUserExpression::Execute (Stream &error_stream,
                               ExecutionContext &exe_ctx,
@@ -537,6 +678,13 @@ ClangUserExpression::Execute (Stream &error_stream,
         else
             return lldb::eExecutionSetupError;
     }
+    else if (CanInterpret())
+    {
+        if (Interpret (error_stream, exe_ctx, result))
+            return lldb::eExecutionCompleted;
+        else
+            return lldb::eExecutionSetupError;
+    }
     else
     {
         error_stream.Printf("Expression can't be run; neither DWARF nor a JIT compiled function is present");
@@ -0,0 +1,820 @@
+//===-- IRInterpreter.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/IRInterpreter.h"
+
+#include "llvm/ADT/APInt.h"
+#include "llvm/Constants.h"
+#include "llvm/Function.h"
+#include "llvm/InstrTypes.h"
+#include "llvm/Instructions.h"
+#include "llvm/IntrinsicInst.h"
+#include "llvm/Module.h"
+#include "llvm/PassManager.h"
+#include "llvm/Support/GetElementPtrTypeIterator.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetData.h"
+#include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Expression/ClangExpressionDeclMap.h"
+#include "lldb/Expression/ClangPersistentVariables.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+
+#include <map>
+#include <vector>
+
+using namespace llvm;
+
+// The most instructions Run() will execute before giving up, so an
+// expression that loops forever can't hang the debugger.
+static const uint32_t g_max_interpreted_instructions = 1000000;
+
+static std::string
+PrintValue(const Value *value, bool truncate = false)
+{
+    std::string s;
+    raw_string_ostream rso(s);
+    value->print(rso);
+    rso.flush();
+    if (truncate)
+        s.resize(s.length() - 1);
+    return s;
+}
+
+IRInterpreter::IRInterpreter (const char *func_name) :
+    m_func_name (func_name),
+    m_module (),
+    m_function (NULL),
+    m_struct_arg (NULL),
+    m_target_data (),
+    m_persistent_offsets ()
+{
+}
+
+IRInterpreter::~IRInterpreter ()
+{
+}
+
+static bool
+CanInterpretType (const Type *type)
+{
+    if (const IntegerType *int_type = dyn_cast<IntegerType>(type))
+        return int_type->getBitWidth() <= 64;
+    return isa<PointerType>(type);
+}
+
+static bool
+CanInterpretOperand (const Value *value)
+{
+    if (isa<Instruction>(value) ||
+        isa<Argument>(value) ||
+        isa<BasicBlock>(value))
+        return true;
+
+    if (isa<ConstantInt>(value) ||
+        isa<ConstantPointerNull>(value) ||
+        isa<UndefValue>(value))
+        return CanInterpretType(value->getType());
+
+    return false;
+}
+
+bool
+IRInterpreter::GetStructMemberOffset (Value *pointer, int64_t &offset)
+{
+    // IRForTarget addresses each member as "getelementptr i8* %$__lldb_arg, i32 offset"
+
+    while (BitCastInst *bit_cast = dyn_cast<BitCastInst>(pointer))
+        pointer = bit_cast->getOperand(0);
+
+    GetElementPtrInst *gep = dyn_cast<GetElementPtrInst>(pointer);
+
+    if (!gep || gep->getPointerOperand() != m_struct_arg || gep->getNumIndices() != 1)
+        return false;
+
+    ConstantInt *offset_int = dyn_cast<ConstantInt>(gep->getOperand(1));
+
+    if (!offset_int)
+        return false;
+
+    offset = offset_int->getSExtValue();
+    return true;
+}
+
+bool
+IRInterpreter::IsLLDBOwnedPointer (Value *pointer)
+{
+    // Strip off any casts and pointer arithmetic to find where the pointer
+    // came from
+
+    while (1)
+    {
+        if (BitCastInst *bit_cast = dyn_cast<BitCastInst>(pointer))
+            pointer = bit_cast->getOperand(0);
+        else if (GetElementPtrInst *gep = dyn_cast<GetElementPtrInst>(pointer))
+            pointer = gep->getPointerOperand();
+        else
+            break;
+    }
+
+    // A pointer into the argument struct
+
+    if (pointer == m_struct_arg)
+        return true;
+
+    // A pointer that was read out of the struct member for a persistent
+    // variable points at memory LLDB allocated for that variable
+
+    if (LoadInst *load = dyn_cast<LoadInst>(pointer))
+    {
+        int64_t offset;
+
+        if (GetStructMemberOffset(load->getPointerOperand(), offset) &&
+            m_persistent_offsets.count(offset))
+            return true;
+    }
+
+    return false;
+}
+
+bool
+IRInterpreter::CanInterpretInstruction (Instruction &inst)
+{
+    switch (inst.getOpcode())
+    {
+    default:
+        return false;
+
+    case Instruction::Add:
+    case Instruction::Sub:
+    case Instruction::Mul:
+    case Instruction::UDiv:
+    case Instruction::SDiv:
+    case Instruction::URem:
+    case Instruction::SRem:
+    case Instruction::Shl:
+    case Instruction::LShr:
+    case Instruction::AShr:
+    case Instruction::And:
+    case Instruction::Or:
+    case Instruction::Xor:
+    case Instruction::ICmp:
+    case Instruction::Trunc:
+    case Instruction::ZExt:
+    case Instruction::SExt:
+    case Instruction::BitCast:
+    case Instruction::PtrToInt:
+    case Instruction::IntToPtr:
+    case Instruction::GetElementPtr:
+    case Instruction::Load:
+    case Instruction::Select:
+    case Instruction::PHI:
+        if (!CanInterpretType(inst.getType()))
+            return false;
+        break;
+
+    case Instruction::Br:
+        break;
+
+    case Instruction::Ret:
+        // The wrapper function returns void
+        if (inst.getNumOperands() != 0)
+            return false;
+        break;
+
+    case Instruction::Store:
+        if (!IsLLDBOwnedPointer(cast<StoreInst>(inst).getPointerOperand()))
+            return false;
+        break;
+
+    case Instruction::Call:
+        // Debug information intrinsics don't do anything
+        return isa<DbgInfoIntrinsic>(inst);
+    }
+
+    for (unsigned operand_index = 0, num_operands = inst.getNumOperands();
+         operand_index < num_operands;
+         ++operand_index)
+    {
+        Value *operand = inst.getOperand(operand_index);
+
+        if (!CanInterpretOperand(operand))
+            return false;
+
+        if (!isa<BasicBlock>(operand) && !CanInterpretType(operand->getType()))
+            return false;
+    }
+
+    return true;
+}
+
+bool
+IRInterpreter::Prepare (Module &llvm_module,
+                        lldb_private::ClangExpressionDeclMap &decl_map,
+                        lldb_private::ExecutionContext &exe_ctx)
+{
+    lldb::LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+
+    m_module.reset();
+    m_function = NULL;
+    m_struct_arg = NULL;
+    m_persistent_offsets.clear();
+
+    if (!exe_ctx.target)
+        return false;
+
+    Function *original_function = llvm_module.getFunction(StringRef(m_func_name.c_str()));
+
+    if (!original_function || original_function->isDeclaration())
+        return false;
+
+    bool has_struct_arg = false;
+
+    for (Function::arg_iterator arg_pos = original_function->arg_begin(), arg_end = original_function->arg_end();
+         arg_pos != arg_end;
+         ++arg_pos)
+    {
+        if (arg_pos->getName().equals("$__lldb_arg"))
+            has_struct_arg = true;
+        else if (!arg_pos->getName().equals("this") &&
+                 !arg_pos->getName().equals("self") &&
+                 !arg_pos->getName().equals("_cmd"))
+            return false;
+    }
+
+    if (!has_struct_arg)
+        return false;
+
+    // We rewrite the function below, so work on a copy of the module.  The
+    // caller's module is JIT compiled unchanged if we can't interpret it.
+
+    std::auto_ptr<Module> module_ap(CloneModule(&llvm_module));
+
+    Function *function = module_ap->getFunction(StringRef(m_func_name.c_str()));
+
+    if (!function)
+        return false;
+
+    for (Function::arg_iterator arg_pos = function->arg_begin(), arg_end = function->arg_end();
+         arg_pos != arg_end;
+         ++arg_pos)
+    {
+        if (arg_pos->getName().equals("$__lldb_arg"))
+            m_struct_arg = arg_pos;
+    }
+
+    if (!m_struct_arg)
+        return false;
+
+    // The unoptimized IR keeps every local (including the argument) in
+    // stack memory.  Promote them to registers so the only memory left is
+    // the target's.
+
+    FunctionPassManager function_pass_manager(module_ap.get());
+    function_pass_manager.add(createPromoteMemoryToRegisterPass());
+    function_pass_manager.doInitialization();
+    function_pass_manager.run(*function);
+    function_pass_manager.doFinalization();
+
+    // Find the struct members whose memory belongs to LLDB
+
+    uint32_t num_elements;
+    size_t size;
+    off_t alignment;
+
+    if (!decl_map.GetStructInfo (num_elements, size, alignment))
+    {
+        m_struct_arg = NULL;
+        return false;
+    }
+
+    lldb_private::ClangPersistentVariables &persistent_vars = exe_ctx.target->GetPersistentVariables();
+
+    for (uint32_t element_index = 0; element_index < num_elements; ++element_index)
+    {
+        const clang::NamedDecl *decl;
+        Value *value;
+        off_t offset;
+        lldb_private::ConstString name;
+
+        if (!decl_map.GetStructElement (decl, value, offset, name, element_index))
+        {
+            m_persistent_offsets.clear();
+            m_struct_arg = NULL;
+            return false;
+        }
+
+        if (name.AsCString("!")[0] == '$' && persistent_vars.GetVariable(name).get())
+            m_persistent_offsets.insert(offset);
+    }
+
+    for (Function::iterator bb = function->begin(), bb_end = function->end();
+         bb != bb_end;
+         ++bb)
+    {
+        for (BasicBlock::iterator ii = bb->begin(), ii_end = bb->end();
+             ii != ii_end;
+             ++ii)
+        {
+            if (!CanInterpretInstruction(*ii))
+            {
+                if (log)
+                    log->Printf("IRInterpreter can't interpret \"%s\"", PrintValue(&*ii, true).c_str());
+
+                m_persistent_offsets.clear();
+                m_struct_arg = NULL;
+                return false;
+            }
+        }
+    }
+
+    m_target_data.reset(new TargetData(module_ap.get()));
+    m_module = module_ap;
+    m_function = function;
+
+    if (log)
+        log->Printf("IRInterpreter will interpret %s()", m_func_name.c_str());
+
+    return true;
+}
+
+//----------------------------------------------------------------------
+// The state of one call to Run()
+//----------------------------------------------------------------------
+class InterpreterFrame
+{
+public:
+    typedef std::map<const Value *, APInt> ValueMap;
+
+    InterpreterFrame (lldb_private::ExecutionContext &exe_ctx,
+                      TargetData &target_data,
+                      lldb_private::Error &err) :
+        m_exe_ctx (exe_ctx),
+        m_target_data (target_data),
+        m_err (err),
+        m_values (),
+        m_byte_order (exe_ctx.process->GetByteOrder()),
+        m_addr_byte_size (exe_ctx.process->GetAddressByteSize())
+    {
+    }
+
+    void
+    SetValue (const Value *value, const APInt &data)
+    {
+        ValueMap::iterator pos = m_values.find(value);
+
+        if (pos == m_values.end())
+            m_values.insert(std::make_pair(value, data));
+        else
+            pos->second = data;
+    }
+
+    bool
+    GetValue (const Value *value, APInt &data)
+    {
+        unsigned bit_width = m_target_data.getTypeSizeInBits(value->getType());
+
+        if (const ConstantInt *constant_int = dyn_cast<ConstantInt>(value))
+        {
+            data = constant_int->getValue();
+            return true;
+        }
+
+        if (isa<ConstantPointerNull>(value) || isa<UndefValue>(value))
+        {
+            data = APInt(bit_width, 0);
+            return true;
+        }
+
+        ValueMap::iterator pos = m_values.find(value);
+
+        if (pos == m_values.end())
+        {
+            m_err.SetErrorStringWithFormat("IR value used before it was computed: %s", PrintValue(value, true).c_str());
+            return false;
+        }
+
+        data = pos->second;
+        return true;
+    }
+
+    bool
+    ReadMemory (lldb::addr_t addr, const Type *type, APInt &data)
+    {
+        const size_t byte_size = m_target_data.getTypeStoreSize(type);
+        uint8_t bytes[8];
+
+        if (byte_size > sizeof(bytes))
+        {
+            m_err.SetErrorString("IR load is too large");
+            return false;
+        }
+
+        lldb_private::Error read_error;
+
+        if (m_exe_ctx.process->ReadMemory(addr, bytes, byte_size, read_error) != byte_size)
+        {
+            m_err.SetErrorStringWithFormat("Couldn't read from 0x%llx: %s", (uint64_t)addr, read_error.AsCString("unknown error"));
+            return false;
+        }
+
+        lldb_private::DataExtractor extractor(bytes, byte_size, m_byte_order, m_addr_byte_size);
+        uint32_t offset = 0;
+
+        data = APInt(m_target_data.getTypeSizeInBits(type), extractor.GetMaxU64(&offset, byte_size));
+        return true;
+    }
+
+    bool
+    WriteMemory (lldb::addr_t addr, const Type *type, const APInt &data)
+    {
+        const size_t byte_size = m_target_data.getTypeStoreSize(type);
+        uint8_t bytes[8];
+
+        if (byte_size > sizeof(bytes))
+        {
+            m_err.SetErrorString("IR store is too large");
+            return false;
+        }
+
+        uint64_t value = data.getZExtValue();
+
+        for (size_t byte_index = 0; byte_index < byte_size; ++byte_index)
+        {
+            uint8_t byte = (value >> (8 * byte_index)) & 0xff;
+
+            if (m_byte_order == lldb::eByteOrderBig)
+                bytes[byte_size - 1 - byte_index] = byte;
+            else
+                bytes[byte_index] = byte;
+        }
+
+        lldb_private::Error write_error;
+
+        if (m_exe_ctx.process->WriteMemory(addr, bytes, byte_size, write_error) != byte_size)
+        {
+            m_err.SetErrorStringWithFormat("Couldn't write to 0x%llx: %s", (uint64_t)addr, write_error.AsCString("unknown error"));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool
+    ComputeAddress (const GetElementPtrInst &gep, APInt &address)
+    {
+        if (!GetValue(gep.getPointerOperand(), address))
+            return false;
+
+        const unsigned pointer_bit_width = address.getBitWidth();
+        int64_t byte_offset = 0;
+
+        for (gep_type_iterator gti = gep_type_begin(gep), gte = gep_type_end(gep);
+             gti != gte;
+             ++gti)
+        {
+            APInt index;
+
+            if (!GetValue(gti.getOperand(), index))
+                return false;
+
+            if (const StructType *struct_type = dyn_cast<StructType>(*gti))
+            {
+                const StructLayout *struct_layout = m_target_data.getStructLayout(struct_type);
+                byte_offset += struct_layout->getElementOffset(index.getZExtValue());
+            }
+            else
+            {
+                byte_offset += index.getSExtValue() * (int64_t)m_target_data.getTypeAllocSize(gti.getIndexedType());
+            }
+        }
+
+        address = address + APInt(pointer_bit_width, byte_offset, true);
+        return true;
+    }
+
+private:
+    lldb_private::ExecutionContext &m_exe_ctx;
+    TargetData                     &m_target_data;
+    lldb_private::Error            &m_err;
+    ValueMap                        m_values;
+    lldb::ByteOrder                 m_byte_order;
+    uint32_t                        m_addr_byte_size;
+};
+
+bool
+IRInterpreter::Run (lldb_private::ExecutionContext &exe_ctx,
+                    lldb::addr_t struct_address,
+                    lldb::addr_t object_ptr,
+                    lldb::addr_t cmd_ptr,
+                    lldb_private::Error &err)
+{
+    lldb::LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+
+    if (!m_function || !m_target_data.get())
+    {
+        err.SetErrorString("No function has been prepared for interpretation");
+        return false;
+    }
+
+    if (!exe_ctx.process)
+    {
+        err.SetErrorString("Interpreting an expression requires a process");
+        return false;
+    }
+
+    InterpreterFrame frame(exe_ctx, *m_target_data, err);
+
+    const unsigned pointer_bit_width = m_target_data->getPointerSizeInBits();
+
+    for (Function::arg_iterator arg_pos = m_function->arg_begin(), arg_end = m_function->arg_end();
+         arg_pos != arg_end;
+         ++arg_pos)
+    {
+        lldb::addr_t arg_value = struct_address;
+
+        if (arg_pos->getName().equals("this") || arg_pos->getName().equals("self"))
+            arg_value = object_ptr;
+        else if (arg_pos->getName().equals("_cmd"))
+            arg_value = cmd_ptr;
+
+        frame.SetValue(arg_pos, APInt(pointer_bit_width, arg_value));
+    }
+
+    const BasicBlock *prev_bb = NULL;
+    const BasicBlock *bb = &m_function->getEntryBlock();
+    uint32_t num_executed = 0;
+
+    while (bb)
+    {
+        // Evaluate all the PHI nodes before any of them are updated, since
+        // they may refer to each other
+
+        BasicBlock::const_iterator ii = bb->begin();
+        std::vector<std::pair<const PHINode *, APInt> > phi_values;
+
+        for (; isa<PHINode>(ii); ++ii)
+        {
+            const PHINode *phi = cast<PHINode>(ii);
+            APInt phi_value;
+
+            if (!prev_bb || !frame.GetValue(phi->getIncomingValueForBlock(prev_bb), phi_value))
+            {
+                if (err.Success())
+                    err.SetErrorString("Couldn't evaluate an IR PHI node");
+                return false;
+            }
+
+            phi_values.push_back(std::make_pair(phi, phi_value));
+        }
+
+        for (size_t phi_index = 0; phi_index < phi_values.size(); ++phi_index)
+            frame.SetValue(phi_values[phi_index].first, phi_values[phi_index].second);
+
+        const BasicBlock *next_bb = NULL;
+
+        for (BasicBlock::const_iterator ie = bb->end(); ii != ie; ++ii)
+        {
+            const Instruction *inst = &*ii;
+
+            if (++num_executed > g_max_interpreted_instructions)
+            {
+                err.SetErrorString("Expression took too long to interpret");
+                return false;
+            }
+
+            switch (inst->getOpcode())
+            {
+            default:
+                err.SetErrorStringWithFormat("Can't interpret %s", PrintValue(inst, true).c_str());
+                return false;
+
+            case Instruction::Add:
+            case Instruction::Sub:
+            case Instruction::Mul:
+            case Instruction::UDiv:
+            case Instruction::SDiv:
+            case Instruction::URem:
+            case Instruction::SRem:
+            case Instruction::Shl:
+            case Instruction::LShr:
+            case Instruction::AShr:
+            case Instruction::And:
+            case Instruction::Or:
+            case Instruction::Xor:
+                {
+                    APInt lhs;
+                    APInt rhs;
+
+                    if (!frame.GetValue(inst->getOperand(0), lhs) ||
+                        !frame.GetValue(inst->getOperand(1), rhs))
+                        return false;
+
+                    APInt result;
+
+                    switch (inst->getOpcode())
+                    {
+                    default:                    break;
+                    case Instruction::Add:      result = lhs + rhs; break;
+                    case Instruction::Sub:      result = lhs - rhs; break;
+                    case Instruction::Mul:      result = lhs * rhs; break;
+                    case Instruction::And:      result = lhs & rhs; break;
+                    case Instruction::Or:       result = lhs | rhs; break;
+                    case Instruction::Xor:      result = lhs ^ rhs; break;
+                    case Instruction::UDiv:
+                    case Instruction::SDiv:
+                    case Instruction::URem:
+                    case Instruction::SRem:
+                        if (rhs == 0)
+                        {
+                            err.SetErrorString("Division by zero");
+                            return false;
+                        }
+                        switch (inst->getOpcode())
+                        {
+                        default:                    break;
+                        case Instruction::UDiv:     result = lhs.udiv(rhs); break;
+                        case Instruction::SDiv:     result = lhs.sdiv(rhs); break;
+                        case Instruction::URem:     result = lhs.urem(rhs); break;
+                        case Instruction::SRem:     result = lhs.srem(rhs); break;
+                        }
+                        break;
+                    case Instruction::Shl:
+                    case Instruction::LShr:
+                    case Instruction::AShr:
+                        if (rhs.uge(lhs.getBitWidth()))
+                        {
+                            err.SetErrorString("Shift amount is too large");
+                            return false;
+                        }
+                        switch (inst->getOpcode())
+                        {
+                        default:                    break;
+                        case Instruction::Shl:      result = lhs.shl((unsigned)rhs.getZExtValue()); break;
+                        case Instruction::LShr:     result = lhs.lshr((unsigned)rhs.getZExtValue()); break;
+                        case Instruction::AShr:     result = lhs.ashr((unsigned)rhs.getZExtValue()); break;
+                        }
+                        break;
+                    }
+
+                    frame.SetValue(inst, result);
+                }
+                break;
+
+            case Instruction::ICmp:
+                {
+                    const ICmpInst *icmp = cast<ICmpInst>(inst);
+                    APInt lhs;
+                    APInt rhs;
+
+                    if (!frame.GetValue(icmp->getOperand(0), lhs) ||
+                        !frame.GetValue(icmp->getOperand(1), rhs))
+                        return false;
+
+                    bool result;
+
+                    switch (icmp->getPredicate())
+                    {
+                    default:
+                        err.SetErrorStringWithFormat("Can't interpret %s", PrintValue(inst, true).c_str());
+                        return false;
+                    case CmpInst::ICMP_EQ:  result = lhs.eq(rhs); break;
+                    case CmpInst::ICMP_NE:  result = lhs.ne(rhs); break;
+                    case CmpInst::ICMP_UGT: result = lhs.ugt(rhs); break;
+                    case CmpInst::ICMP_UGE: result = lhs.uge(rhs); break;
+                    case CmpInst::ICMP_ULT: result = lhs.ult(rhs); break;
+                    case CmpInst::ICMP_ULE: result = lhs.ule(rhs); break;
+                    case CmpInst::ICMP_SGT: result = lhs.sgt(rhs); break;
+                    case CmpInst::ICMP_SGE: result = lhs.sge(rhs); break;
+                    case CmpInst::ICMP_SLT: result = lhs.slt(rhs); break;
+                    case CmpInst::ICMP_SLE: result = lhs.sle(rhs); break;
+                    }
+
+                    frame.SetValue(inst, APInt(1, result ? 1 : 0));
+                }
+                break;
+
+            case Instruction::Trunc:
+            case Instruction::ZExt:
+            case Instruction::SExt:
+            case Instruction::BitCast:
+            case Instruction::PtrToInt:
+            case Instruction::IntToPtr:
+                {
+                    APInt source;
+
+                    if (!frame.GetValue(inst->getOperand(0), source))
+                        return false;
+
+                    unsigned bit_width = m_target_data->getTypeSizeInBits(inst->getType());
+
+                    if (inst->getOpcode() == Instruction::SExt)
+                        frame.SetValue(inst, source.sextOrTrunc(bit_width));
+                    else
+                        frame.SetValue(inst, source.zextOrTrunc(bit_width));
+                }
+                break;
+
+            case Instruction::GetElementPtr:
+                {
+                    APInt address;
+
+                    if (!frame.ComputeAddress(*cast<GetElementPtrInst>(inst), address))
+                        return false;
+
+                    frame.SetValue(inst, address);
+                }
+                break;
+
+            case Instruction::Load:
+                {
+                    const LoadInst *load = cast<LoadInst>(inst);
+                    APInt address;
+                    APInt loaded;
+
+                    if (!frame.GetValue(load->getPointerOperand(), address) ||
+                        !frame.ReadMemory(address.getZExtValue(), load->getType(), loaded))
+                        return false;
+
+                    frame.SetValue(inst, loaded);
+                }
+                break;
+
+            case Instruction::Store:
+                {
+                    const StoreInst *store = cast<StoreInst>(inst);
+                    APInt address;
+                    APInt stored;
+
+                    if (!frame.GetValue(store->getPointerOperand(), address) ||
+                        !frame.GetValue(store->getValueOperand(), stored) ||
+                        !frame.WriteMemory(address.getZExtValue(), store->getValueOperand()->getType(), stored))
+                        return false;
+                }
+                break;
+
+            case Instruction::Select:
+                {
+                    APInt condition;
+                    APInt selected;
+
+                    if (!frame.GetValue(inst->getOperand(0), condition) ||
+                        !frame.GetValue(inst->getOperand(condition.getBoolValue() ? 1 : 2), selected))
+                        return false;
+
+                    frame.SetValue(inst, selected);
+                }
+                break;
+
+            case Instruction::Call:
+                // Only debug information intrinsics get through Prepare()
+                break;
+
+            case Instruction::Br:
+                {
+                    const BranchInst *branch = cast<BranchInst>(inst);
+
+                    if (branch->isConditional())
+                    {
+                        APInt condition;
+
+                        if (!frame.GetValue(branch->getCondition(), condition))
+                            return false;
+
+                        next_bb = branch->getSuccessor(condition.getBoolValue() ? 0 : 1);
+                    }
+                    else
+                    {
+                        next_bb = branch->getSuccessor(0);
+                    }
+                }
+                break;
+
+            case Instruction::Ret:
+                next_bb = NULL;
+                break;
+            }
+        }
+
+        prev_bb = bb;
+        bb = next_bb;
+    }
+
+    if (log)
+        log->Printf("IRInterpreter ran %s() in %u instructions", m_func_name.c_str(), num_executed);
+
+    return true;
+}
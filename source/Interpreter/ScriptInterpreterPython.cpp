@@ -35,8 +35,8 @@ extern "C" void init_lldb (void);
 extern "C" bool
 LLDBSWIGPythonBreakpointCallbackFunction 
 (
-    const char *python_function_name,
-    const char *session_dictionary_name,
+    PyObject *pfunc,
+    PyObject *session_dict,
     lldb::SBFrame& sb_frame, 
     lldb::SBBreakpointLocation& sb_bp_loc
 );
@@ -44,6 +44,11 @@ LLDBSWIGPythonBreakpointCallbackFunction
 using namespace lldb;
 using namespace lldb_private;
 
+// The interpreter whose session (lldb.debugger_unique_id, sys.stdout and
+// sys.stdin) is currently set up in Python, and the thread that set it up.
+static ScriptInterpreterPython *g_bound_session = NULL;
+static lldb::tid_t g_bound_session_tid = LLDB_INVALID_THREAD_ID;
+
 const char embedded_interpreter_string[] =
 "import readline\n\
 import code\n\
@@ -204,7 +209,9 @@ ScriptInterpreterPython::ScriptInterpreterPython (CommandInterpreter &interprete
     m_terminal_state (),
     m_session_is_active (false),
     m_pty_slave_is_open (false),
-    m_valid_session (true)
+    m_valid_session (true),
+    m_session_dict (NULL),
+    m_breakpoint_callables ()
 {
 
     static int g_initialized = false;
@@ -301,18 +308,30 @@ ScriptInterpreterPython::~ScriptInterpreterPython ()
         debugger.PopInputReader (reader_sp);
     }
     
-    if (m_new_sysout)
+    if (g_bound_session == this)
+        g_bound_session = NULL;
+
+    if (m_new_sysout || m_session_dict || !m_breakpoint_callables.empty())
     {
         FILE *tmp_fh = (m_dbg_stdout ? m_dbg_stdout : stdout);
+        bool need_to_release_lock = false;
         if (!CurrentThreadHasPythonLock ())
         {
             while (!GetPythonLock (1))
                 fprintf (tmp_fh, "Python interpreter locked on another thread; waiting to acquire lock...\n");
-            Py_DECREF (m_new_sysout);
-            ReleasePythonLock ();
+            need_to_release_lock = true;
         }
-        else
-            Py_DECREF (m_new_sysout);
+
+        Py_XDECREF (m_new_sysout);
+        Py_XDECREF (m_session_dict);
+
+        std::map<std::string, PyObject *>::iterator pos, end = m_breakpoint_callables.end();
+        for (pos = m_breakpoint_callables.begin(); pos != end; ++pos)
+            Py_DECREF (pos->second);
+        m_breakpoint_callables.clear();
+
+        if (need_to_release_lock)
+            ReleasePythonLock ();
     }
 }
 
@@ -340,6 +359,10 @@ ScriptInterpreterPython::ResetOutputFileHandle (FILE *fh)
         m_new_sysout = PyFile_FromFile (m_dbg_stdout, (char *) "", (char *) "w", _check_and_flush);
         LeaveSession ();
     }
+
+    // The next session has to install the new sys.stdout.
+    if (g_bound_session == this)
+        g_bound_session = NULL;
 }
 
 void
@@ -381,12 +404,24 @@ ScriptInterpreterPython::EnterSession ()
 
     m_session_is_active = true;
 
+    // The session stays set up after LeaveSession (), so a thread that keeps
+    // coming back to the same interpreter (e.g. a breakpoint callback that
+    // runs on every hit) has nothing to do here.
+    const lldb::tid_t current_tid = Host::GetCurrentThreadID ();
+    if (g_bound_session == this && g_bound_session_tid == current_tid && m_pty_slave_is_open)
+        return;
+
+    g_bound_session = this;
+    g_bound_session_tid = current_tid;
+
     StreamString run_string;
 
-    run_string.Printf ("run_one_line (%s, 'lldb.debugger_unique_id = %d')", m_dictionary_name.c_str(),
-                       GetCommandInterpreter().GetDebugger().GetID());
-    PyRun_SimpleString (run_string.GetData());
-    
+    PyObject *lldb_module = PyImport_AddModule ("lldb");
+    PyObject *debugger_id = PyInt_FromLong (GetCommandInterpreter().GetDebugger().GetID());
+    if (lldb_module != NULL && debugger_id != NULL)
+        PyObject_SetAttrString (lldb_module, "debugger_unique_id", debugger_id);
+    Py_XDECREF (debugger_id);
+
 
     PyObject *sysmod = PyImport_AddModule ("sys");
     PyObject *sysdict = PyModule_GetDict (sysmod);
@@ -1251,12 +1286,67 @@ ScriptInterpreterPython::GenerateBreakpointCommandCallbackData (StringList &user
         return false;
     }
 
-    // Store the name of the auto-generated function to be called.
+    // Store the name of the auto-generated function to be called, and look the function up now so the
+    // breakpoint callback doesn't have to.
 
     callback_data.AppendString (auto_generated_function_name.c_str());
+
+    if (CurrentThreadHasPythonLock())
+        GetBreakpointCallable (auto_generated_function_name.c_str());
+    else if (GetPythonLock (1))
+    {
+        GetBreakpointCallable (auto_generated_function_name.c_str());
+        ReleasePythonLock ();
+    }
     return true;
 }
 
+PyObject *
+ScriptInterpreterPython::GetSessionDictionary ()
+{
+    if (m_session_dict == NULL)
+    {
+        PyObject *main_module = PyImport_AddModule ("__main__");
+        PyObject *main_dict = (main_module ? PyModule_GetDict (main_module) : NULL);
+        if (main_dict != NULL)
+        {
+            PyObject *session_dict = PyDict_GetItemString (main_dict, m_dictionary_name.c_str());
+            if (session_dict != NULL && PyDict_Check (session_dict))
+            {
+                Py_INCREF (session_dict);
+                m_session_dict = session_dict;
+            }
+        }
+        if (PyErr_Occurred ())
+            PyErr_Clear ();
+    }
+    return m_session_dict;
+}
+
+PyObject *
+ScriptInterpreterPython::GetBreakpointCallable (const char *python_function_name)
+{
+    std::map<std::string, PyObject *>::iterator pos = m_breakpoint_callables.find (python_function_name);
+    if (pos != m_breakpoint_callables.end())
+        return pos->second;
+
+    PyObject *session_dict = GetSessionDictionary ();
+    if (session_dict == NULL)
+        return NULL;
+
+    PyObject *pfunc = PyDict_GetItemString (session_dict, python_function_name);
+    if (pfunc == NULL || !PyCallable_Check (pfunc))
+    {
+        if (PyErr_Occurred ())
+            PyErr_Clear ();
+        return NULL;
+    }
+
+    Py_INCREF (pfunc);
+    m_breakpoint_callables[python_function_name] = pfunc;
+    return pfunc;
+}
+
 bool
 ScriptInterpreterPython::BreakpointCallbackFunction 
 (
@@ -1302,8 +1392,8 @@ ScriptInterpreterPython::BreakpointCallbackFunction
             if (CurrentThreadHasPythonLock())
             {
                 python_interpreter->EnterSession ();
-                ret_val = LLDBSWIGPythonBreakpointCallbackFunction(python_function_name, 
-                                                                   python_interpreter->m_dictionary_name.c_str(),
+                ret_val = LLDBSWIGPythonBreakpointCallbackFunction(python_interpreter->GetBreakpointCallable (python_function_name), 
+                                                                   python_interpreter->GetSessionDictionary (),
                                                                    sb_frame, sb_bp_loc);
                 python_interpreter->LeaveSession ();
             }
@@ -1313,8 +1403,8 @@ ScriptInterpreterPython::BreakpointCallbackFunction
                     fprintf (tmp_fh, 
                              "Python interpreter locked on another thread; waiting to acquire lock...\n");
                 python_interpreter->EnterSession ();
-                ret_val = LLDBSWIGPythonBreakpointCallbackFunction(python_function_name, 
-                                                                   python_interpreter->m_dictionary_name.c_str(),
+                ret_val = LLDBSWIGPythonBreakpointCallbackFunction(python_interpreter->GetBreakpointCallable (python_function_name), 
+                                                                   python_interpreter->GetSessionDictionary (),
                                                                    sb_frame, sb_bp_loc);
                 python_interpreter->LeaveSession ();
                 ReleasePythonLock ();
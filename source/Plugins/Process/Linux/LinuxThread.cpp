@@ -12,6 +12,7 @@
 
 // C++ Includes
 // Other libraries and framework includes
+#include "lldb/Breakpoint/WatchpointLocation.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StopInfo.h"
@@ -22,6 +23,7 @@
 #include "ProcessMonitor.h"
 #include "RegisterContextLinux_i386.h"
 #include "RegisterContextLinux_x86_64.h"
+#include "UnwindFramePointer.h"
 #include "UnwindLLDB.h"
 
 using namespace lldb_private;
@@ -29,8 +31,10 @@ using namespace lldb_private;
 LinuxThread::LinuxThread(Process &process, lldb::tid_t tid)
     : Thread(process, tid),
       m_frame_ap(0),
+      m_watchpoint_id(LLDB_INVALID_BREAK_ID),
       m_stop_info_id(0),
-      m_note(eNone)
+      m_note(eNone),
+      m_unwinder_uses_frame_pointer(false)
 {
 }
 
@@ -128,7 +132,16 @@ Unwind *
 LinuxThread::GetUnwinder()
 {
     if (m_unwinder_ap.get() == NULL)
-        m_unwinder_ap.reset(new UnwindLLDB(*this));
+    {
+        const llvm::Triple::ArchType machine = GetProcess().GetTarget().GetArchitecture().GetMachine();
+
+        m_unwinder_uses_frame_pointer = GetFramePointerUnwindEnabled();
+        if (m_unwinder_uses_frame_pointer &&
+            (machine == llvm::Triple::x86_64 || machine == llvm::Triple::x86))
+            m_unwinder_ap.reset(new UnwindFramePointer(*this));
+        else
+            m_unwinder_ap.reset(new UnwindLLDB(*this));
+    }
 
     return m_unwinder_ap.get();
 }
@@ -140,7 +153,13 @@ LinuxThread::WillResume(lldb::StateType resume_state)
 
     ClearStackFrames();
     if (m_unwinder_ap.get())
-        m_unwinder_ap->Clear();
+    {
+        // Switch unwinders if the frame-pointer-unwind setting changed.
+        if (m_unwinder_uses_frame_pointer != GetFramePointerUnwindEnabled())
+            m_unwinder_ap.reset();
+        else
+            m_unwinder_ap->Clear();
+    }
 
     return Thread::WillResume(resume_state);
 }
@@ -196,6 +215,25 @@ LinuxThread::BreakNotify()
     m_breakpoint = bp_site;
 }
 
+void
+LinuxThread::WatchNotify(uint32_t hw_index)
+{
+    ProcessLinux &process = static_cast<ProcessLinux&>(GetProcess());
+    WatchpointLocation *wp = process.GetHardwareWatchpoint(hw_index);
+
+    // The watchpoint may have been disabled since the debug registers were
+    // last written.  Report the trap as a plain trace in that case.
+    if (wp == NULL)
+    {
+        TraceNotify();
+        return;
+    }
+
+    wp->IncrementHitCount();
+    m_note = eWatch;
+    m_watchpoint_id = wp->GetID();
+}
+
 void
 LinuxThread::TraceNotify()
 {
@@ -225,6 +263,11 @@ LinuxThread::RefreshPrivateStopReason()
             *this, m_breakpoint->GetID());
         break;
 
+    case eWatch:
+        m_stop_info = StopInfo::CreateStopReasonWithWatchpointID(
+            *this, m_watchpoint_id);
+        break;
+
     case eTrace:
         m_stop_info = StopInfo::CreateStopReasonToTrace(*this);
         break;
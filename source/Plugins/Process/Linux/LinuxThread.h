@@ -52,6 +52,7 @@ public:
     bool Resume();
 
     void BreakNotify();
+    void WatchNotify(uint32_t hw_index);
     void TraceNotify();
     void ExitNotify();
 
@@ -75,6 +76,9 @@ private:
     std::auto_ptr<lldb_private::StackFrame> m_frame_ap;
 
     lldb::BreakpointSiteSP m_breakpoint;
+
+    // The watchpoint that was hit, when m_note is eWatch.
+    lldb::break_id_t m_watchpoint_id;
     lldb::StopInfoSP m_stop_info;
 
     // Cached process stop id.  Used to ensure we do not recalculate stop
@@ -84,12 +88,17 @@ private:
     enum Notification {
         eNone,
         eBreak,
+        eWatch,
         eTrace,
         eExit
     };
 
     Notification m_note;
 
+    // Whether m_unwinder_ap was created with the frame-pointer-unwind
+    // setting enabled.
+    bool m_unwinder_uses_frame_pointer;
+
     ProcessMonitor &GetMonitor();
 
     lldb::StopInfoSP
@@ -10,6 +10,7 @@
 // C Includes
 // C++ Includes
 // Other libraries and framework includes
+#include "lldb/Breakpoint/WatchpointLocation.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Symbol/ObjectFile.h"
@@ -70,8 +71,12 @@ ProcessLinux::GetPluginDescriptionStatic()
 ProcessLinux::ProcessLinux(Target& target, Listener &listener)
     : Process(target, listener),
       m_monitor(NULL),
-      m_module(NULL)
+      m_module(NULL),
+      m_hw_watchpoints_mutex(Mutex::eMutexTypeNormal)
 {
+    for (uint32_t i = 0; i < kNumHardwareWatchpoints; ++i)
+        m_hw_watchpoints[i] = NULL;
+
     // FIXME: Putting this code in the ctor and saving the byte order in a
     // member variable is a hack to avoid const qual issues in GetByteOrder.
     ObjectFile *obj_file = GetTarget().GetExecutableModule()->GetObjectFile();
@@ -299,6 +304,10 @@ ProcessLinux::RefreshStateAfterStop()
     case ProcessMessage::eBreakpointMessage:
         thread->BreakNotify();
         break;
+
+    case ProcessMessage::eWatchpointMessage:
+        thread->WatchNotify(message.GetHardwareIndex());
+        break;
     }
 
     m_message_queue.pop();
@@ -382,6 +391,146 @@ ProcessLinux::DisableBreakpoint(BreakpointSite *bp_site)
     return DisableSoftwareBreakpoint(bp_site);
 }
 
+Error
+ProcessLinux::EnableWatchpoint(WatchpointLocation *wp)
+{
+    Error error;
+
+    if (wp == NULL)
+    {
+        error.SetErrorString("Watchpoint location argument was NULL.");
+        return error;
+    }
+
+    if (wp->IsEnabled())
+        return error;
+
+    // Each debug register watches 1, 2, 4 or (on x86_64) 8 bytes that must be
+    // aligned to their size.
+    const addr_t addr = wp->GetLoadAddress();
+    const size_t size = wp->GetByteSize();
+    const bool size_ok = size == 1 || size == 2 || size == 4 ||
+                         (size == 8 && GetAddressByteSize() == 8);
+    if (!size_ok || (addr % size) != 0)
+    {
+        error.SetErrorStringWithFormat("Can't watch %zu bytes at 0x%llx: hardware watchpoints must be 1, 2, 4%s bytes long and aligned to their size.",
+                                       size, (uint64_t)addr,
+                                       GetAddressByteSize() == 8 ? " or 8" : "");
+        return error;
+    }
+
+    if (!wp->WatchpointRead() && !wp->WatchpointWrite())
+    {
+        error.SetErrorString("Watchpoint must watch reads, writes or both.");
+        return error;
+    }
+
+    // Claim a slot.  The lock isn't held while the debug registers are
+    // written since that waits for the monitor's operation thread.
+    uint32_t hw_index;
+    {
+        Mutex::Locker lock(m_hw_watchpoints_mutex);
+        for (hw_index = 0; hw_index < kNumHardwareWatchpoints; ++hw_index)
+        {
+            if (m_hw_watchpoints[hw_index] == NULL)
+                break;
+        }
+
+        if (hw_index == kNumHardwareWatchpoints)
+        {
+            error.SetErrorStringWithFormat("All %u hardware watchpoints are in use.",
+                                           kNumHardwareWatchpoints);
+            return error;
+        }
+        m_hw_watchpoints[hw_index] = wp;
+    }
+
+    if (!SetHardwareWatchpointInAllThreads(hw_index, wp))
+    {
+        SetHardwareWatchpointInAllThreads(hw_index, NULL);
+        Mutex::Locker lock(m_hw_watchpoints_mutex);
+        m_hw_watchpoints[hw_index] = NULL;
+        error.SetErrorString("Couldn't write the debug registers.");
+        return error;
+    }
+
+    wp->SetHardwareIndex(hw_index);
+    wp->SetEnabled(true);
+    return error;
+}
+
+Error
+ProcessLinux::DisableWatchpoint(WatchpointLocation *wp)
+{
+    Error error;
+
+    if (wp == NULL)
+    {
+        error.SetErrorString("Watchpoint location argument was NULL.");
+        return error;
+    }
+
+    if (!wp->IsEnabled())
+        return error;
+
+    const uint32_t hw_index = wp->GetHardwareIndex();
+    if (GetHardwareWatchpoint(hw_index) == wp)
+    {
+        if (!SetHardwareWatchpointInAllThreads(hw_index, NULL))
+            error.SetErrorString("Couldn't write the debug registers.");
+        Mutex::Locker lock(m_hw_watchpoints_mutex);
+        m_hw_watchpoints[hw_index] = NULL;
+    }
+
+    wp->SetEnabled(false);
+    return error;
+}
+
+WatchpointLocation *
+ProcessLinux::GetHardwareWatchpoint(uint32_t hw_index)
+{
+    Mutex::Locker lock(m_hw_watchpoints_mutex);
+    if (hw_index < kNumHardwareWatchpoints)
+        return m_hw_watchpoints[hw_index];
+    return NULL;
+}
+
+bool
+ProcessLinux::HasHardwareWatchpoints() const
+{
+    Mutex::Locker lock(m_hw_watchpoints_mutex);
+    for (uint32_t i = 0; i < kNumHardwareWatchpoints; ++i)
+    {
+        if (m_hw_watchpoints[i])
+            return true;
+    }
+    return false;
+}
+
+bool
+ProcessLinux::SetHardwareWatchpointInAllThreads(uint32_t hw_index,
+                                                WatchpointLocation *wp)
+{
+    ThreadList &threads = GetThreadList();
+    const uint32_t num_threads = threads.GetSize(false);
+    bool success = true;
+
+    for (uint32_t i = 0; i < num_threads; ++i)
+    {
+        lldb::tid_t tid = threads.GetThreadAtIndex(i, false)->GetID();
+
+        if (wp)
+            success &= m_monitor->SetHardwareWatchpoint(tid, hw_index,
+                                                        wp->GetLoadAddress(),
+                                                        wp->GetByteSize(),
+                                                        wp->WatchpointRead(),
+                                                        wp->WatchpointWrite());
+        else
+            success &= m_monitor->ClearHardwareWatchpoint(tid, hw_index);
+    }
+    return success;
+}
+
 uint32_t
 ProcessLinux::UpdateThreadListIfNeeded()
 {
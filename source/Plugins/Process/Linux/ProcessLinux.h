@@ -129,6 +129,12 @@ public:
     virtual lldb_private::Error
     DisableBreakpoint(lldb_private::BreakpointSite *bp_site);
 
+    virtual lldb_private::Error
+    EnableWatchpoint(lldb_private::WatchpointLocation *wp_loc);
+
+    virtual lldb_private::Error
+    DisableWatchpoint(lldb_private::WatchpointLocation *wp_loc);
+
     virtual uint32_t
     UpdateThreadListIfNeeded();
 
@@ -169,6 +175,14 @@ public:
 
     ProcessMonitor &GetMonitor() { return *m_monitor; }
 
+    /// Returns the watchpoint using the given debug register slot, or NULL if
+    /// the slot is free.
+    lldb_private::WatchpointLocation *
+    GetHardwareWatchpoint(uint32_t hw_index);
+
+    /// Returns true if any debug register slot is in use.
+    bool HasHardwareWatchpoints() const;
+
 private:
     /// Target byte order.
     lldb::ByteOrder m_byte_order;
@@ -183,6 +197,20 @@ private:
     lldb_private::Mutex m_message_mutex;
     std::queue<ProcessMessage> m_message_queue;
 
+    /// The x86 debug registers provide four watchpoint slots.
+    enum { kNumHardwareWatchpoints = 4 };
+
+    /// The watchpoint using each debug register slot, or NULL.  The monitor
+    /// thread checks these on every debug trap, so they are guarded by
+    /// m_hw_watchpoints_mutex.
+    mutable lldb_private::Mutex m_hw_watchpoints_mutex;
+    lldb_private::WatchpointLocation *m_hw_watchpoints[kNumHardwareWatchpoints];
+
+    /// Programs (or, if @p wp_loc is NULL, clears) the given debug register
+    /// slot in every thread.
+    bool SetHardwareWatchpointInAllThreads(uint32_t hw_index,
+                                           lldb_private::WatchpointLocation *wp_loc);
+
     /// Updates the loaded sections provided by the executable.
     ///
     /// FIXME:  It would probably be better to delegate this task to the
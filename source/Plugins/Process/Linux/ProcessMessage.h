@@ -27,7 +27,8 @@ public:
         eLimboMessage,
         eSignalMessage,
         eTraceMessage,
-        eBreakpointMessage
+        eBreakpointMessage,
+        eWatchpointMessage
     };
 
     ProcessMessage()
@@ -59,6 +60,12 @@ public:
         return ProcessMessage(tid, eBreakpointMessage);
     }
 
+    /// Indicates that the given thread triggered the hardware watchpoint in
+    /// debug register slot @p hw_index.
+    static ProcessMessage Watch(lldb::tid_t tid, uint32_t hw_index) {
+        return ProcessMessage(tid, eWatchpointMessage, hw_index);
+    }
+
     int GetExitStatus() const {
         assert(GetKind() == eExitMessage || GetKind() == eLimboMessage);
         return m_data;
@@ -74,6 +81,11 @@ public:
         return m_data;
     }
 
+    uint32_t GetHardwareIndex() const {
+        assert(GetKind() == eWatchpointMessage);
+        return m_data;
+    }
+
 private:
     ProcessMessage(lldb::tid_t tid, Kind kind, int data = 0)
         : m_kind(kind),
@@ -10,11 +10,13 @@
 // C Includes
 #include <errno.h>
 #include <poll.h>
+#include <stddef.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/ptrace.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/user.h>
 #include <sys/wait.h>
 
 // C++ Includes
@@ -114,6 +116,66 @@ DoWriteMemory(lldb::pid_t pid, unsigned word_size,
     return bytes_written;
 }
 
+//------------------------------------------------------------------------------
+// Static helpers for the x86 debug registers.  DR0-DR3 hold the watched
+// addresses, DR6 reports which of them caused a trap and DR7 enables them.
+// DR7 has two enable bits per slot starting at bit 0, and four bits per slot
+// starting at bit 16 that give the access type (low two bits) and the length
+// (high two bits).
+
+#ifndef TRAP_HWBKPT
+#define TRAP_HWBKPT 4
+#endif
+
+static const unsigned k_num_debug_address_regs = 4;
+static const unsigned k_debug_status_reg = 6;
+static const unsigned k_debug_control_reg = 7;
+
+static bool
+ReadDebugRegister(lldb::tid_t tid, unsigned index, unsigned long &value)
+{
+    const unsigned offset = offsetof(struct user, u_debugreg) +
+                            index * sizeof(((struct user *)0)->u_debugreg[0]);
+
+    errno = 0;
+    value = ptrace(PTRACE_PEEKUSER, tid, offset, NULL);
+    return !(value == -1UL && errno);
+}
+
+static bool
+WriteDebugRegister(lldb::tid_t tid, unsigned index, unsigned long value)
+{
+    const unsigned offset = offsetof(struct user, u_debugreg) +
+                            index * sizeof(((struct user *)0)->u_debugreg[0]);
+
+    return ptrace(PTRACE_POKEUSER, tid, offset, value) == 0;
+}
+
+static unsigned long
+DebugControlMask(uint32_t hw_index)
+{
+    return (3UL << (2 * hw_index)) | (0xfUL << (16 + 4 * hw_index));
+}
+
+static unsigned long
+DebugControlBits(uint32_t hw_index, size_t size, bool read, bool write)
+{
+    // Access type: 01 traps on writes, 11 on reads and writes.
+    const unsigned long rw = read ? 3UL : 1UL;
+
+    // Length: 00 is one byte, 01 two, 11 four and 10 eight.
+    unsigned long len;
+    switch (size)
+    {
+    default:
+    case 1: len = 0UL; break;
+    case 2: len = 1UL; break;
+    case 4: len = 3UL; break;
+    case 8: len = 2UL; break;
+    }
+
+    return (1UL << (2 * hw_index)) | ((rw | (len << 2)) << (16 + 4 * hw_index));
+}
 
 //------------------------------------------------------------------------------
 /// @class Operation
@@ -311,6 +373,100 @@ ReadFPROperation::Execute(ProcessMonitor *monitor)
         m_result = true;
 }
 
+//------------------------------------------------------------------------------
+/// @class WatchpointOperation
+/// @brief Implements ProcessMonitor::SetHardwareWatchpoint and
+/// ProcessMonitor::ClearHardwareWatchpoint.
+class WatchpointOperation : public Operation
+{
+public:
+    WatchpointOperation(lldb::tid_t tid, uint32_t hw_index,
+                        lldb::addr_t addr, size_t size,
+                        bool read, bool write, bool enable, bool &result)
+        : m_tid(tid), m_hw_index(hw_index), m_addr(addr), m_size(size),
+          m_read(read), m_write(write), m_enable(enable), m_result(result)
+        { }
+
+    void Execute(ProcessMonitor *monitor);
+
+private:
+    lldb::tid_t m_tid;
+    uint32_t m_hw_index;
+    lldb::addr_t m_addr;
+    size_t m_size;
+    bool m_read;
+    bool m_write;
+    bool m_enable;
+    bool &m_result;
+};
+
+void
+WatchpointOperation::Execute(ProcessMonitor *monitor)
+{
+    unsigned long control;
+
+    m_result = false;
+    if (m_hw_index >= k_num_debug_address_regs ||
+        !ReadDebugRegister(m_tid, k_debug_control_reg, control))
+        return;
+
+    control &= ~DebugControlMask(m_hw_index);
+
+    // The kernel checks the address registers against DR7, so the address
+    // must be written before the slot is enabled and cleared after it is
+    // disabled.
+    if (m_enable)
+    {
+        control |= DebugControlBits(m_hw_index, m_size, m_read, m_write);
+        m_result = WriteDebugRegister(m_tid, m_hw_index, m_addr) &&
+                   WriteDebugRegister(m_tid, k_debug_control_reg, control);
+    }
+    else
+    {
+        m_result = WriteDebugRegister(m_tid, k_debug_control_reg, control) &&
+                   WriteDebugRegister(m_tid, m_hw_index, 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @class WatchpointHitOperation
+/// @brief Implements ProcessMonitor::GetHardwareWatchpointHitIndex.
+class WatchpointHitOperation : public Operation
+{
+public:
+    WatchpointHitOperation(lldb::tid_t tid, uint32_t &hw_index)
+        : m_tid(tid), m_hw_index(hw_index) { }
+
+    void Execute(ProcessMonitor *monitor);
+
+private:
+    lldb::tid_t m_tid;
+    uint32_t &m_hw_index;
+};
+
+void
+WatchpointHitOperation::Execute(ProcessMonitor *monitor)
+{
+    unsigned long status;
+
+    m_hw_index = LLDB_INVALID_INDEX32;
+    if (!ReadDebugRegister(m_tid, k_debug_status_reg, status))
+        return;
+
+    for (unsigned i = 0; i < k_num_debug_address_regs; ++i)
+    {
+        if (status & (1UL << i))
+        {
+            m_hw_index = i;
+            break;
+        }
+    }
+
+    // The processor never clears DR6 itself.
+    if (status)
+        WriteDebugRegister(m_tid, k_debug_status_reg, 0);
+}
+
 //------------------------------------------------------------------------------
 /// @class ResumeOperation
 /// @brief Implements ProcessMonitor::Resume.
@@ -804,8 +960,22 @@ ProcessMonitor::MonitorSIGTRAP(ProcessMonitor *monitor, lldb::pid_t pid)
 
     case 0:
     case TRAP_TRACE:
-        message = ProcessMessage::Trace(pid);
+    case TRAP_HWBKPT:
+    {
+        // Hardware watchpoint hits are debug exceptions, just like single
+        // steps.  Only DR6 tells them apart, so don't read it unless a
+        // watchpoint could have fired.
+        uint32_t hw_index = LLDB_INVALID_INDEX32;
+        if (info.si_code == TRAP_HWBKPT ||
+            monitor->GetProcess().HasHardwareWatchpoints())
+            hw_index = monitor->GetHardwareWatchpointHitIndex(pid);
+
+        if (hw_index != LLDB_INVALID_INDEX32)
+            message = ProcessMessage::Watch(pid, hw_index);
+        else
+            message = ProcessMessage::Trace(pid);
         break;
+    }
 
     case SI_KERNEL:
     case TRAP_BRKPT:
@@ -948,6 +1118,35 @@ ProcessMonitor::ReadFPR(void *buf)
     return result;
 }
 
+bool
+ProcessMonitor::SetHardwareWatchpoint(lldb::tid_t tid, uint32_t hw_index,
+                                      lldb::addr_t addr, size_t size,
+                                      bool read, bool write)
+{
+    bool result;
+    WatchpointOperation op(tid, hw_index, addr, size, read, write, true, result);
+    DoOperation(&op);
+    return result;
+}
+
+bool
+ProcessMonitor::ClearHardwareWatchpoint(lldb::tid_t tid, uint32_t hw_index)
+{
+    bool result;
+    WatchpointOperation op(tid, hw_index, 0, 0, false, false, false, result);
+    DoOperation(&op);
+    return result;
+}
+
+uint32_t
+ProcessMonitor::GetHardwareWatchpointHitIndex(lldb::tid_t tid)
+{
+    uint32_t hw_index;
+    WatchpointHitOperation op(tid, hw_index);
+    DoOperation(&op);
+    return hw_index;
+}
+
 bool
 ProcessMonitor::Resume(lldb::tid_t tid)
 {
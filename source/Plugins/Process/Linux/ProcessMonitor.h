@@ -127,6 +127,26 @@ public:
     bool
     GetEventMessage(lldb::tid_t tid, unsigned long *message);
 
+    /// Programs debug register slot @p hw_index (0-3) of the given thread to
+    /// trap when any of the @p size bytes at @p addr are accessed.  The size
+    /// must be 1, 2, 4 or 8 and @p addr must be aligned to it.  x86 can't
+    /// trap on reads alone, so a read watchpoint traps on writes too.
+    bool
+    SetHardwareWatchpoint(lldb::tid_t tid, uint32_t hw_index,
+                          lldb::addr_t addr, size_t size,
+                          bool read, bool write);
+
+    /// Disables debug register slot @p hw_index of the given thread.
+    bool
+    ClearHardwareWatchpoint(lldb::tid_t tid, uint32_t hw_index);
+
+    /// Returns the debug register slot that caused the last trap in the given
+    /// thread, or LLDB_INVALID_INDEX32 if the trap was not a watchpoint hit.
+    /// The debug status register is cleared so the next trap is not
+    /// mistaken for a hit.
+    uint32_t
+    GetHardwareWatchpointHitIndex(lldb::tid_t tid);
+
     /// Resumes the given thread.
     bool
     Resume(lldb::tid_t tid);
@@ -19,6 +19,8 @@
 #include "lldb/Target/Process.h"
 #include "lldb/Utility/ArchDefaultUnwindPlan.h"
 #include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/UnwindTable.h"
 #include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Utility/ArchVolatileRegs.h"
 #include "lldb/Core/Log.h"
@@ -295,6 +297,99 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         return;
     }
 
+    const UnwindPlan::Row *active_row = NULL;
+    int cfa_offset = 0;
+    int row_register_kind;
+
+    // Frames called from _sigtramp or a debugger frame choose their UnwindPlans differently,
+    // so only use the per-module unwind row cache for frames called from a normal frame.
+    ObjectFile *objfile = m_current_pc.GetModule()->GetObjectFile();
+    const bool use_unwind_row_cache = objfile != NULL && m_next_frame->m_frame_type == eNormalFrame;
+    const addr_t pc_file_addr = m_current_pc.GetFileAddress();
+    UnwindTable::CachedUnwindRow cached_row;
+    if (use_unwind_row_cache && objfile->GetUnwindTable().GetCachedUnwindRow (pc_file_addr, cached_row))
+    {
+        m_sym_ctx = cached_row.sym_ctx;
+        // The cache doesn't hold onto the module, put it back the way
+        // ResolveSymbolContextForAddress would have set it
+        m_sym_ctx.module_sp = m_current_pc.GetModule()->GetSP();
+        m_sym_ctx_valid = cached_row.sym_ctx_valid;
+        m_start_pc = cached_row.start_pc;
+        m_current_offset = cached_row.current_offset;
+        m_current_offset_backed_up_one = cached_row.current_offset_backed_up_one;
+        m_fast_unwind_plan_sp = cached_row.fast_unwind_plan_sp;
+        m_full_unwind_plan_sp = cached_row.full_unwind_plan_sp;
+        m_frame_type = eNormalFrame;
+        active_row = cached_row.active_row;
+        row_register_kind = cached_row.row_register_kind;
+    }
+    else
+    {
+        active_row = FindActiveRowForNonZerothFrame (row_register_kind);
+        if (use_unwind_row_cache && active_row && m_frame_type == eNormalFrame)
+        {
+            cached_row.sym_ctx = m_sym_ctx;
+            cached_row.sym_ctx_valid = m_sym_ctx_valid;
+            cached_row.start_pc = m_start_pc;
+            cached_row.current_offset = m_current_offset;
+            cached_row.current_offset_backed_up_one = m_current_offset_backed_up_one;
+            cached_row.fast_unwind_plan_sp = m_fast_unwind_plan_sp;
+            cached_row.full_unwind_plan_sp = m_full_unwind_plan_sp;
+            cached_row.active_row = active_row;
+            cached_row.row_register_kind = row_register_kind;
+            objfile->GetUnwindTable().SetCachedUnwindRow (pc_file_addr, cached_row);
+        }
+    }
+
+    if (active_row == NULL)
+    {
+        m_frame_type = eNotAValidFrame;
+        return;
+    }
+
+    addr_t cfa_regval;
+    if (!ReadGPRValue (row_register_kind, active_row->GetCFARegister(), cfa_regval))
+    {
+        if (log)
+        {
+            log->Printf("%*sFrame %u failed to get cfa reg %d/%d",
+                        m_frame_number < 100 ? m_frame_number : 100, "", m_frame_number,
+                        row_register_kind, active_row->GetCFARegister());
+        }
+        m_frame_type = eNotAValidFrame;
+        return;
+    }
+    cfa_offset = active_row->GetCFAOffset ();
+
+    m_cfa = cfa_regval + cfa_offset;
+
+    // A couple of sanity checks..
+    if (cfa_regval == LLDB_INVALID_ADDRESS || cfa_regval == 0 || cfa_regval == 1)
+    { 
+        if (log)
+        {
+            log->Printf("%*sFrame %u could not find a valid cfa address",
+                        m_frame_number < 100 ? m_frame_number : 100, "", m_frame_number);
+        }
+        m_frame_type = eNotAValidFrame;
+        return;
+    }
+
+    if (log)
+    {
+        log->Printf("%*sFrame %u initialized frame current pc is 0x%llx cfa is 0x%llx", 
+                    m_frame_number < 100 ? m_frame_number : 100, "", m_frame_number,
+                    (uint64_t) m_current_pc.GetLoadAddress (&m_thread.GetProcess().GetTarget()), (uint64_t) m_cfa);
+    }
+}
+
+
+// Find the symbol context, UnwindPlans and the active UnwindPlan row for a non-zeroth frame 
+// whose m_current_pc has been resolved to an address in a Module.
+
+const UnwindPlan::Row *
+RegisterContextLLDB::FindActiveRowForNonZerothFrame (int &row_register_kind)
+{
     // We require that eSymbolContextSymbol be successfully filled in or this context is of no use to us.
     if ((m_current_pc.GetModule()->ResolveSymbolContextForAddress (m_current_pc, eSymbolContextFunction| eSymbolContextSymbol, m_sym_ctx) & eSymbolContextSymbol) == eSymbolContextSymbol)
     {
@@ -378,8 +473,6 @@ RegisterContextLLDB::InitializeNonZerothFrame()
     m_fast_unwind_plan_sp = GetFastUnwindPlanForFrame ();
 
     const UnwindPlan::Row *active_row = NULL;
-    int cfa_offset = 0;
-    int row_register_kind;
 
     // Try to get by with just the fast UnwindPlan if possible - the full UnwindPlan may be expensive to get
     // (e.g. if we have to parse the entire eh_frame section of an ObjectFile for the first time.)
@@ -399,49 +492,9 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         }
     }
 
-    if (active_row == NULL)
-    {
-        m_frame_type = eNotAValidFrame;
-        return;
-    }
-
-    addr_t cfa_regval;
-    if (!ReadGPRValue (row_register_kind, active_row->GetCFARegister(), cfa_regval))
-    {
-        if (log)
-        {
-            log->Printf("%*sFrame %u failed to get cfa reg %d/%d",
-                        m_frame_number < 100 ? m_frame_number : 100, "", m_frame_number,
-                        row_register_kind, active_row->GetCFARegister());
-        }
-        m_frame_type = eNotAValidFrame;
-        return;
-    }
-    cfa_offset = active_row->GetCFAOffset ();
-
-    m_cfa = cfa_regval + cfa_offset;
-
-    // A couple of sanity checks..
-    if (cfa_regval == LLDB_INVALID_ADDRESS || cfa_regval == 0 || cfa_regval == 1)
-    { 
-        if (log)
-        {
-            log->Printf("%*sFrame %u could not find a valid cfa address",
-                        m_frame_number < 100 ? m_frame_number : 100, "", m_frame_number);
-        }
-        m_frame_type = eNotAValidFrame;
-        return;
-    }
-
-    if (log)
-    {
-        log->Printf("%*sFrame %u initialized frame current pc is 0x%llx cfa is 0x%llx", 
-                    m_frame_number < 100 ? m_frame_number : 100, "", m_frame_number,
-                    (uint64_t) m_current_pc.GetLoadAddress (&m_thread.GetProcess().GetTarget()), (uint64_t) m_cfa);
-    }
+    return active_row;
 }
 
-
 bool
 RegisterContextLLDB::IsFrameZero () const
 {
@@ -38,6 +38,21 @@ RegisterContextMacOSXFrameBackchain::RegisterContextMacOSXFrameBackchain
 {
 }
 
+RegisterContextMacOSXFrameBackchain::RegisterContextMacOSXFrameBackchain
+(
+    Thread &thread,
+    uint32_t concrete_frame_idx,
+    lldb::addr_t pc,
+    lldb::addr_t fp
+) :
+    RegisterContext (thread, concrete_frame_idx),
+    m_cursor (),
+    m_cursor_is_valid (true)
+{
+    m_cursor.pc = pc;
+    m_cursor.fp = fp;
+}
+
 //----------------------------------------------------------------------
 // Destructor
 //----------------------------------------------------------------------
@@ -102,7 +117,7 @@ RegisterContextMacOSXFrameBackchain::ReadRegisterValue (uint32_t reg, Scalar &va
     case LLDB_REGNUM_GENERIC_FP:
         if (m_cursor.fp == LLDB_INVALID_ADDRESS)
             return false;
-        reg_value = m_cursor.pc;
+        reg_value = m_cursor.fp;
         break;
     
     default:
@@ -29,6 +29,11 @@ public:
                                          uint32_t concrete_frame_idx,
                                          const UnwindMacOSXFrameBackchain::Cursor &cursor);
 
+    RegisterContextMacOSXFrameBackchain (lldb_private::Thread &thread,
+                                         uint32_t concrete_frame_idx,
+                                         lldb::addr_t pc,
+                                         lldb::addr_t fp);
+
     virtual
     ~RegisterContextMacOSXFrameBackchain ();
 
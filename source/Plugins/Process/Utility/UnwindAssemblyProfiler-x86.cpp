@@ -12,6 +12,7 @@
 #include "lldb/lldb-private.h"
 #include "lldb/Utility/UnwindAssemblyProfiler.h"
 #include "lldb/Core/Address.h"
+#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/PluginManager.h"
@@ -121,7 +122,8 @@ static int x86_64_register_map_initialized = 0;
 class AssemblyParse_x86 {
 public:
 
-    AssemblyParse_x86 (Target &target, Thread *thread, int cpu, AddressRange func);
+    AssemblyParse_x86 (Target &target, Thread *thread, int cpu, AddressRange func, 
+                       EDDisassemblerRef disasm, const DataBufferSP &func_bytes_sp);
 
     bool get_non_call_site_unwind_plan (UnwindPlan &unwind_plan);
 
@@ -143,12 +145,18 @@ private:
     uint32_t extract_4 (uint8_t *b);
     bool machine_regno_to_lldb_regno (int machine_regno, uint32_t& lldb_regno);
     bool instruction_length (Address addr, int &length);
+    bool read_instruction_bytes (Address addr, int length);
 
     Target &m_target;
     Thread* m_thread;
 
     AddressRange m_func_bounds;
 
+    // All of the function bytes we have, read once up front so we
+    // don't go to the target for each instruction (or each byte)
+    EDDisassemblerRef m_disasm;
+    DataBufferSP m_func_bytes_sp;
+
     Address m_cur_insn;
     uint8_t m_cur_insn_bytes[kMaxInstructionByteSize];
 
@@ -166,8 +174,10 @@ private:
     DISALLOW_COPY_AND_ASSIGN (AssemblyParse_x86);
 };
 
-AssemblyParse_x86::AssemblyParse_x86 (Target& target, Thread* thread, int cpu, AddressRange func) :
+AssemblyParse_x86::AssemblyParse_x86 (Target& target, Thread* thread, int cpu, AddressRange func, 
+                                      EDDisassemblerRef disasm, const DataBufferSP &func_bytes_sp) :
                          m_target (target), m_thread (thread), m_cpu(cpu), m_func_bounds(func),
+                         m_disasm (disasm), m_func_bytes_sp (func_bytes_sp),
                          m_machine_ip_regnum (-1), m_machine_sp_regnum (-1), m_machine_fp_regnum (-1),
                          m_lldb_ip_regnum (-1), m_lldb_sp_regnum (-1), m_lldb_fp_regnum (-1),
                          m_wordsize (-1), m_cur_insn ()
@@ -451,8 +461,8 @@ AssemblyParse_x86::machine_regno_to_lldb_regno (int machine_regno, uint32_t &lld
 
 struct edis_byte_read_token 
 {
-    Address *address;
-    Target *target;
+    const uint8_t *bytes;
+    size_t size;
 };
 
 
@@ -462,51 +472,30 @@ read_byte_for_edis (uint8_t *buf, uint64_t offset_address, void *arg)
     if (arg == 0)
         return -1;
     struct edis_byte_read_token *tok = (edis_byte_read_token *) arg;
-    Address *base_address = tok->address;
-    Target *target = tok->target;
-
-    Address read_addr = *base_address;
-    read_addr.SetOffset (offset_address);
 
-    uint8_t onebyte_buf[1];
-    Error error;
-    const bool prefer_file_cache = true;
-    if (target->ReadMemory (read_addr, prefer_file_cache, onebyte_buf, 1, error) != -1)
-    {
-        *buf = onebyte_buf[0];
-        return 0;
-    }
-    return -1;
+    // "offset_address" is the offset into the function bytes
+    if (offset_address >= tok->size)
+        return -1;
+    *buf = tok->bytes[offset_address];
+    return 0;
 }
 
 
 bool
 AssemblyParse_x86::instruction_length (Address addr, int &length)
 {
-    const char *triple;
-
-    if (!addr.IsValid())
+    if (!addr.IsValid() || m_disasm == NULL || m_func_bytes_sp.get() == NULL)
         return false;
 
-    // FIXME should probably pass down the ArchSpec and work from that to make a portable triple
-    if (m_cpu == k_i386)
-        triple = "i386-unknown-unknown";
-    else
-        triple = "x86_64-unknown-unknown";
-
-    EDDisassemblerRef disasm;
-    EDInstRef         cur_insn;
-
-    if (EDGetDisassembler (&disasm, triple, kEDAssemblySyntaxX86ATT) != 0)
-    {
+    const lldb::addr_t func_offset = addr.GetOffset() - m_func_bounds.GetBaseAddress().GetOffset();
+    if (func_offset >= m_func_bytes_sp->GetByteSize())
         return false;
-    }
 
-    uint64_t addr_offset = addr.GetOffset();
+    EDInstRef cur_insn;
     struct edis_byte_read_token arg;
-    arg.address = &addr;
-    arg.target = &m_target;
-    if (EDCreateInsts (&cur_insn, 1, disasm, read_byte_for_edis, addr_offset, &arg) != 1)
+    arg.bytes = m_func_bytes_sp->GetBytes();
+    arg.size = m_func_bytes_sp->GetByteSize();
+    if (EDCreateInsts (&cur_insn, 1, m_disasm, read_byte_for_edis, func_offset, &arg) != 1)
     {
         return false;
     }
@@ -515,6 +504,19 @@ AssemblyParse_x86::instruction_length (Address addr, int &length)
     return true;
 }
 
+// Copy the bytes for the instruction at "addr" out of the function bytes
+bool
+AssemblyParse_x86::read_instruction_bytes (Address addr, int length)
+{
+    if (m_func_bytes_sp.get() == NULL || length > kMaxInstructionByteSize)
+        return false;
+    const lldb::addr_t func_offset = addr.GetOffset() - m_func_bounds.GetBaseAddress().GetOffset();
+    if (func_offset + length > m_func_bytes_sp->GetByteSize())
+        return false;
+    ::memcpy (m_cur_insn_bytes, m_func_bytes_sp->GetBytes() + func_offset, length);
+    return true;
+}
+
 
 bool 
 AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
@@ -550,7 +552,6 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
     row.SetRegisterInfo (m_lldb_ip_regnum, initial_regloc);
 
     unwind_plan.AppendRow (row);
-    const bool prefer_file_cache = true;
 
     while (m_func_bounds.ContainsFileAddress (m_cur_insn) && non_prologue_insn_count < 10)
     {
@@ -563,9 +564,9 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
             // An unrecognized/junk instruction
             break;
         }
-        if (m_target.ReadMemory (m_cur_insn, prefer_file_cache, m_cur_insn_bytes, insn_len, error) == -1)
+        if (!read_instruction_bytes (m_cur_insn, insn_len))
         {
-           // Error reading the instruction out of the file, stop scanning
+           // We ran off the end of the function bytes, stop scanning
            break;
         }
 
@@ -673,7 +674,18 @@ loopnext:
         Address last_insn (m_func_bounds.GetBaseAddress());
         last_insn.SetOffset (last_insn.GetOffset() + m_func_bounds.GetByteSize() - 1);
         uint8_t bytebuf[1];
-        if (m_target.ReadMemory (last_insn, prefer_file_cache, bytebuf, 1, error) != -1)
+        bool got_last_byte = false;
+        if (m_func_bytes_sp.get() && m_func_bytes_sp->GetByteSize() == m_func_bounds.GetByteSize())
+        {
+            bytebuf[0] = m_func_bytes_sp->GetBytes()[m_func_bounds.GetByteSize() - 1];
+            got_last_byte = true;
+        }
+        else
+        {
+            const bool prefer_file_cache = true;
+            got_last_byte = m_target.ReadMemory (last_insn, prefer_file_cache, bytebuf, 1, error) == 1;
+        }
+        if (got_last_byte)
         {
             if (bytebuf[0] == 0xc3)   // ret aka retq
             {
@@ -723,10 +735,17 @@ AssemblyParse_x86::get_fast_unwind_plan (AddressRange& func, UnwindPlan &unwind_
         return false;
 
     uint8_t bytebuf[4];
-    Error error;
-    const bool prefer_file_cache = true;
-    if (m_target.ReadMemory (func.GetBaseAddress(), prefer_file_cache, bytebuf, sizeof (bytebuf), error) == -1)
-        return false;
+    if (m_func_bytes_sp.get() && m_func_bytes_sp->GetByteSize() >= sizeof (bytebuf))
+    {
+        ::memcpy (bytebuf, m_func_bytes_sp->GetBytes(), sizeof (bytebuf));
+    }
+    else
+    {
+        Error error;
+        const bool prefer_file_cache = true;
+        if (m_target.ReadMemory (func.GetBaseAddress(), prefer_file_cache, bytebuf, sizeof (bytebuf), error) != sizeof (bytebuf))
+            return false;
+    }
 
     uint8_t i386_prologue[] = {0x55, 0x89, 0xe5};
     uint8_t x86_64_prologue[] = {0x55, 0x48, 0x89, 0xe5};
@@ -783,19 +802,17 @@ AssemblyParse_x86::find_first_non_prologue_insn (Address &address)
         return false;
     }
 
-    const bool prefer_file_cache = true;
     while (m_func_bounds.ContainsFileAddress (m_cur_insn))
     {
-        Error error;
         int insn_len, offset, regno;
         if (!instruction_length (m_cur_insn, insn_len) || insn_len > kMaxInstructionByteSize || insn_len == 0)
         {
             // An error parsing the instruction, i.e. probably data/garbage - stop scanning
             break;
         }
-        if (m_target.ReadMemory (m_cur_insn, prefer_file_cache, m_cur_insn_bytes, insn_len, error) == -1)
+        if (!read_instruction_bytes (m_cur_insn, insn_len))
         {
-           // Error reading the instruction out of the file, stop scanning
+           // We ran off the end of the function bytes, stop scanning
            break;
         }
 
@@ -823,24 +840,111 @@ AssemblyParse_x86::find_first_non_prologue_insn (Address &address)
 //  UnwindAssemblyParser_x86 method definitions 
 //-----------------------------------------------------------------------------------------------
 
+EDDisassemblerRef
+UnwindAssemblyProfiler_x86::GetDisassembler ()
+{
+    Mutex::Locker locker (m_mutex);
+    if (!m_tried_disassembler)
+    {
+        m_tried_disassembler = true;
+        // FIXME should probably pass down the ArchSpec and work from that to make a portable triple
+        const char *triple;
+        if (m_cpu == k_i386)
+            triple = "i386-unknown-unknown";
+        else
+            triple = "x86_64-unknown-unknown";
+
+        if (EDGetDisassembler (&m_disassembler, triple, kEDAssemblySyntaxX86ATT) != 0)
+            m_disassembler = NULL;
+    }
+    return m_disassembler;
+}
+
+DataBufferSP
+UnwindAssemblyProfiler_x86::GetFunctionBytes (Target& target, const AddressRange& func)
+{
+    DataBufferSP func_bytes_sp;
+    const Address &func_addr = func.GetBaseAddress();
+    if (!func_addr.IsValid())
+        return func_bytes_sp;
+
+    // We only look at prologue - it will be complete earlier than 512 bytes 
+    // into func (AssemblyParse_x86 uses the same size for unknown ranges)
+    size_t func_size = func.GetByteSize();
+    if (func_size == 0)
+        func_size = 512;
+
+    // There is one profiler per object file so file addresses are unique
+    const lldb::addr_t func_file_addr = func_addr.GetFileAddress();
+
+    Mutex::Locker locker (m_mutex);
+    size_t cached_size = 0;
+    if (m_func_bytes_sp.get() && m_func_bytes_addr == func_file_addr)
+    {
+        cached_size = m_func_bytes_sp->GetByteSize();
+        if (cached_size == func_size)
+            return m_func_bytes_sp;
+
+        if (cached_size > func_size)
+        {
+            // The same function with a smaller range, hand out the prefix
+            func_bytes_sp.reset (new DataBufferHeap (m_func_bytes_sp->GetBytes(), func_size));
+            return func_bytes_sp;
+        }
+
+        // A previous read asked for at least this much and came up short,
+        // the rest isn't readable so don't try again
+        if (m_func_bytes_requested >= func_size)
+            return m_func_bytes_sp;
+    }
+
+    // Reuse the bytes we already have and only read the rest. The cached
+    // buffer may still be in use by another parser so we copy it into a
+    // new buffer rather than growing it.
+    std::auto_ptr<DataBufferHeap> data_ap (new DataBufferHeap (func_size, 0));
+    if (cached_size > 0)
+        ::memcpy (data_ap->GetBytes(), m_func_bytes_sp->GetBytes(), cached_size);
+
+    Address read_addr (func_addr);
+    read_addr.Slide (cached_size);
+    Error error;
+    const bool prefer_file_cache = true;
+    const size_t read_size = func_size - cached_size;
+    const size_t bytes_read = target.ReadMemory (read_addr, prefer_file_cache, data_ap->GetBytes() + cached_size, read_size, error);
+    if (bytes_read > read_size)
+        return func_bytes_sp;
+    if (bytes_read == 0 && cached_size == 0)
+        return func_bytes_sp;
+
+    // Only keep what we were able to read
+    data_ap->SetByteSize (cached_size + bytes_read);
+    func_bytes_sp.reset (data_ap.release());
+    m_func_bytes_addr = func_file_addr;
+    m_func_bytes_requested = func_size;
+    m_func_bytes_sp = func_bytes_sp;
+    return func_bytes_sp;
+}
+
 bool
 UnwindAssemblyProfiler_x86::GetNonCallSiteUnwindPlanFromAssembly (AddressRange& func, Thread& thread, UnwindPlan& unwind_plan)
 {
-    AssemblyParse_x86 asm_parse(thread.GetProcess().GetTarget(), &thread, m_cpu, func);
+    Target &target = thread.GetProcess().GetTarget();
+    AssemblyParse_x86 asm_parse(target, &thread, m_cpu, func, GetDisassembler(), GetFunctionBytes (target, func));
     return asm_parse.get_non_call_site_unwind_plan (unwind_plan);
 }
 
 bool
 UnwindAssemblyProfiler_x86::GetFastUnwindPlan (AddressRange& func, Thread& thread, UnwindPlan &unwind_plan)
 {
-    AssemblyParse_x86 asm_parse(thread.GetProcess().GetTarget(), &thread, m_cpu, func);
+    Target &target = thread.GetProcess().GetTarget();
+    AssemblyParse_x86 asm_parse(target, &thread, m_cpu, func, GetDisassembler(), GetFunctionBytes (target, func));
     return asm_parse.get_fast_unwind_plan (func, unwind_plan);
 }
 
 bool
 UnwindAssemblyProfiler_x86::FirstNonPrologueInsn (AddressRange& func, Target& target, Thread* thread, Address& first_non_prologue_insn)
 {
-    AssemblyParse_x86 asm_parse(target, thread, m_cpu, func);
+    AssemblyParse_x86 asm_parse(target, thread, m_cpu, func, GetDisassembler(), GetFunctionBytes (target, func));
     return asm_parse.find_first_non_prologue_insn (first_non_prologue_insn);
 }
 
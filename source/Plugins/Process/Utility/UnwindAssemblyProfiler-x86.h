@@ -10,7 +10,10 @@
 #ifndef liblldb_UnwindAssemblyProfiler_x86_h_
 #define liblldb_UnwindAssemblyProfiler_x86_h_
 
+#include "llvm-c/EnhancedDisassembly.h"
+
 #include "lldb/lldb-private.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Utility/UnwindAssemblyProfiler.h"
 #include "lldb/Target/Thread.h"
 
@@ -71,9 +74,37 @@ public:
 
 private:
     UnwindAssemblyProfiler_x86(int cpu) : 
-          lldb_private::UnwindAssemblyProfiler(), m_cpu(cpu) { } // Call CreateInstance instead.
+          lldb_private::UnwindAssemblyProfiler(), 
+          m_cpu(cpu),
+          m_mutex (lldb_private::Mutex::eMutexTypeNormal),
+          m_disassembler (NULL),
+          m_tried_disassembler (false),
+          m_func_bytes_addr (LLDB_INVALID_ADDRESS),
+          m_func_bytes_requested (0),
+          m_func_bytes_sp () { } // Call CreateInstance instead.
+
+    EDDisassemblerRef
+    GetDisassembler ();
+
+    lldb::DataBufferSP
+    GetFunctionBytes (lldb_private::Target& target, const lldb_private::AddressRange& func);
 
     int m_cpu;
+
+    lldb_private::Mutex m_mutex;
+
+    // One disassembler handle is used for all the functions we profile
+    EDDisassemblerRef m_disassembler;
+    bool m_tried_disassembler;
+
+    // The bytes of the function we most recently profiled. The fast, 
+    // non call site and first non prologue instruction passes over a
+    // function are typically done back to back, so they share one read.
+    // When a read comes up short we keep what we got and remember how
+    // much was asked for, so a later request only reads what's missing.
+    lldb::addr_t m_func_bytes_addr;
+    size_t m_func_bytes_requested;
+    lldb::DataBufferSP m_func_bytes_sp;
 };
 
 
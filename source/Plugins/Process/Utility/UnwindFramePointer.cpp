@@ -0,0 +1,293 @@
+//===-- UnwindFramePointer.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Address.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+
+#include "RegisterContextMacOSXFrameBackchain.h"
+#include "UnwindFramePointer.h"
+#include "UnwindLLDB.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+UnwindFramePointer::UnwindFramePointer (Thread &thread) :
+    Unwind (thread),
+    m_cursors(),
+    m_walked_chain (false),
+    m_full_unwinder_ap (),
+    m_stack_bytes (),
+    m_stack_bytes_addr (LLDB_INVALID_ADDRESS)
+{
+}
+
+UnwindFramePointer::~UnwindFramePointer()
+{
+}
+
+void
+UnwindFramePointer::Clear()
+{
+    m_cursors.clear();
+    m_walked_chain = false;
+    m_full_unwinder_ap.reset();
+    m_stack_bytes.clear();
+    m_stack_bytes_addr = LLDB_INVALID_ADDRESS;
+}
+
+uint32_t
+UnwindFramePointer::GetFrameCount()
+{
+    if (!m_walked_chain)
+        WalkFramePointerChain ();
+
+    if (m_full_unwinder_ap.get())
+        return m_full_unwinder_ap->GetFrameCount();
+    return m_cursors.size();
+}
+
+bool
+UnwindFramePointer::GetFrameInfoAtIndex (uint32_t idx, addr_t& cfa, addr_t& pc)
+{
+    if (!m_walked_chain)
+        WalkFramePointerChain ();
+
+    if (m_full_unwinder_ap.get())
+        return m_full_unwinder_ap->GetFrameInfoAtIndex (idx, cfa, pc);
+
+    if (idx < m_cursors.size())
+    {
+        pc = m_cursors[idx].pc;
+        cfa = m_cursors[idx].cfa;
+        return true;
+    }
+    return false;
+}
+
+lldb::RegisterContextSP
+UnwindFramePointer::CreateRegisterContextForFrame (StackFrame *frame)
+{
+    if (!m_walked_chain)
+        WalkFramePointerChain ();
+
+    if (m_full_unwinder_ap.get())
+        return m_full_unwinder_ap->CreateRegisterContextForFrame (frame);
+
+    lldb::RegisterContextSP reg_ctx_sp;
+    uint32_t concrete_idx = frame->GetConcreteFrameIndex ();
+    if (concrete_idx == 0)
+        return m_thread.GetRegisterContext();
+
+    if (concrete_idx < m_cursors.size())
+        reg_ctx_sp.reset (new RegisterContextMacOSXFrameBackchain (m_thread,
+                                                                   concrete_idx,
+                                                                   m_cursors[concrete_idx].pc,
+                                                                   m_cursors[concrete_idx].fp));
+    return reg_ctx_sp;
+}
+
+void
+UnwindFramePointer::UseFullUnwinder ()
+{
+    m_cursors.clear();
+    m_full_unwinder_ap.reset (new UnwindLLDB (m_thread));
+}
+
+void
+UnwindFramePointer::WalkFramePointerChain ()
+{
+    m_walked_chain = true;
+    m_cursors.clear();
+
+    LogSP log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    RegisterContext *reg_ctx = m_thread.GetRegisterContext().get();
+    if (reg_ctx == NULL)
+        return;
+
+    Process &process = m_thread.GetProcess();
+    const uint32_t addr_byte_size = process.GetAddressByteSize();
+    const ByteOrder byte_order = process.GetByteOrder();
+
+    Cursor cursor;
+    cursor.pc = reg_ctx->GetPC (LLDB_INVALID_ADDRESS);
+    cursor.fp = reg_ctx->GetFP (0);
+    if (cursor.pc == LLDB_INVALID_ADDRESS || cursor.fp == 0 || !FrameZeroHasValidFramePointer (cursor.pc))
+    {
+        if (log)
+            log->Printf ("UnwindFramePointer: thread %u frame 0 has no frame pointer set up, using the full unwinder",
+                         m_thread.GetIndexID());
+        UseFullUnwinder ();
+        return;
+    }
+    cursor.cfa = cursor.fp + 2 * addr_byte_size;
+    m_cursors.push_back (cursor);
+
+    while (1)
+    {
+        addr_t caller_fp = 0;
+        addr_t caller_pc = 0;
+        if ((cursor.fp % addr_byte_size) != 0 ||
+            !ReadFrameRecord (cursor.fp, addr_byte_size, byte_order, caller_fp, caller_pc))
+        {
+            if (log)
+                log->Printf ("UnwindFramePointer: thread %u frame %zu has an invalid frame pointer 0x%llx, using the full unwinder",
+                             m_thread.GetIndexID(), m_cursors.size() - 1, (uint64_t)cursor.fp);
+            UseFullUnwinder ();
+            return;
+        }
+
+        // A zero return address or frame pointer is the end of the stack.
+        // The outermost frame (e.g. _start) clears the frame pointer, so
+        // there is no CFA we could give it other than a copy of the CFA
+        // of the frame it called.
+        if (caller_pc == 0 || caller_fp == 0)
+            break;
+
+        if (!IsCodeAddress (caller_pc) || caller_fp <= cursor.fp)
+        {
+            if (log)
+                log->Printf ("UnwindFramePointer: thread %u frame %zu has a bad frame record (fp = 0x%llx, pc = 0x%llx), using the full unwinder",
+                             m_thread.GetIndexID(), m_cursors.size(), (uint64_t)caller_fp, (uint64_t)caller_pc);
+            UseFullUnwinder ();
+            return;
+        }
+
+        cursor.pc = caller_pc;
+        cursor.fp = caller_fp;
+        cursor.cfa = caller_fp + 2 * addr_byte_size;
+        m_cursors.push_back (cursor);
+    }
+}
+
+// The frame pointer for frame zero can only be trusted if we aren't in
+// the prologue (before "push %rbp; mov %rsp, %rbp" have executed) or
+// about to return (after the frame pointer was restored).
+
+bool
+UnwindFramePointer::FrameZeroHasValidFramePointer (addr_t pc)
+{
+    Target &target = m_thread.GetProcess().GetTarget();
+    Address pc_addr;
+    if (!target.GetSectionLoadList().ResolveLoadAddress (pc, pc_addr))
+        return false;
+
+    Module *module = pc_addr.GetModule();
+    if (module == NULL || module->GetObjectFile() == NULL)
+        return false;
+
+    SymbolContext sc;
+    module->ResolveSymbolContextForAddress (pc_addr, eSymbolContextFunction | eSymbolContextSymbol, sc);
+    FuncUnwindersSP func_unwinders_sp (module->GetObjectFile()->GetUnwindTable().GetFuncUnwindersContainingAddress (pc_addr, sc));
+    if (!func_unwinders_sp)
+        return false;
+
+    const Address &func_start = func_unwinders_sp->GetFunctionStartAddress();
+    const Address &first_non_prologue_insn = func_unwinders_sp->GetFirstNonPrologueInsn (target);
+    if (!func_start.IsValid() || !first_non_prologue_insn.IsValid())
+        return false;
+
+    const addr_t pc_file_addr = pc_addr.GetFileAddress();
+    if (pc_file_addr >= func_start.GetFileAddress() && pc_file_addr < first_non_prologue_insn.GetFileAddress())
+        return false;
+
+    uint8_t opcode = 0;
+    Error error;
+    const bool prefer_file_cache = true;
+    if (target.ReadMemory (pc_addr, prefer_file_cache, &opcode, 1, error) != 1)
+        return false;
+
+    // ret, ret imm16
+    if (opcode == 0xc3 || opcode == 0xc2)
+        return false;
+
+    return true;
+}
+
+bool
+UnwindFramePointer::IsCodeAddress (addr_t pc)
+{
+    if (pc < 0x1000)
+        return false;
+
+    Address pc_addr;
+    if (!m_thread.GetProcess().GetTarget().GetSectionLoadList().ResolveLoadAddress (pc, pc_addr))
+        return false;
+
+    const Section *section = pc_addr.GetSection();
+    if (section == NULL)
+        return false;
+
+    switch (section->GetType())
+    {
+    case eSectionTypeData:
+    case eSectionTypeZeroFill:
+        return false;
+    default:
+        break;
+    }
+    return true;
+}
+
+// Read the saved frame pointer and return address that "fp" points to.
+// Stack frames are usually close together, so we read the rest of the
+// page that contains "fp" and use it for the frame records that follow.
+
+bool
+UnwindFramePointer::ReadFrameRecord (addr_t fp,
+                                     uint32_t addr_byte_size,
+                                     ByteOrder byte_order,
+                                     addr_t &caller_fp,
+                                     addr_t &caller_pc)
+{
+    const size_t record_size = 2 * addr_byte_size;
+    if (m_stack_bytes_addr == LLDB_INVALID_ADDRESS ||
+        fp < m_stack_bytes_addr ||
+        fp + record_size > m_stack_bytes_addr + m_stack_bytes.size())
+    {
+        const addr_t page_size = Host::GetPageSize();
+        size_t read_size = page_size - (fp % page_size);
+        if (read_size < record_size)
+            read_size = record_size;
+
+        m_stack_bytes.resize (read_size);
+        Error error;
+        const size_t bytes_read = m_thread.GetProcess().ReadMemory (fp, &m_stack_bytes[0], read_size, error);
+        if (bytes_read < record_size)
+        {
+            m_stack_bytes.clear();
+            m_stack_bytes_addr = LLDB_INVALID_ADDRESS;
+            return false;
+        }
+        m_stack_bytes.resize (bytes_read);
+        m_stack_bytes_addr = fp;
+    }
+
+    DataExtractor data (&m_stack_bytes[fp - m_stack_bytes_addr], record_size, byte_order, addr_byte_size);
+    uint32_t offset = 0;
+    caller_fp = data.GetPointer (&offset);
+    caller_pc = data.GetPointer (&offset);
+    return true;
+}
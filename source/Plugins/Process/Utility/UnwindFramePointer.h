@@ -0,0 +1,111 @@
+//===-- UnwindFramePointer.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef lldb_UnwindFramePointer_h_
+#define lldb_UnwindFramePointer_h_
+
+// C Includes
+// C++ Includes
+#include <memory>
+#include <vector>
+
+// Other libraries and framework includes
+
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Target/Unwind.h"
+
+//----------------------------------------------------------------------
+// UnwindFramePointer
+//
+// A fast unwinder for i386 and x86_64 that walks the saved frame
+// pointer chain and doesn't look at any unwind information. It is
+// meant for taking lots of backtraces quickly (e.g. sampling all
+// threads). If frame zero is in a prologue or epilogue, or the frame
+// pointer chain looks wrong, all requests are handed off to a full
+// UnwindLLDB unwinder for the rest of the stop.
+//
+// Only the pc and frame pointer are available for frames other than
+// frame zero.
+//----------------------------------------------------------------------
+class UnwindFramePointer : public lldb_private::Unwind
+{
+public:
+    UnwindFramePointer (lldb_private::Thread &thread);
+
+    virtual
+    ~UnwindFramePointer();
+
+    virtual void
+    Clear();
+
+    virtual uint32_t
+    GetFrameCount();
+
+    bool
+    GetFrameInfoAtIndex (uint32_t frame_idx,
+                         lldb::addr_t& cfa,
+                         lldb::addr_t& pc);
+
+    lldb::RegisterContextSP
+    CreateRegisterContextForFrame (lldb_private::StackFrame *frame);
+
+    // Returns true if the frame pointer chain couldn't be trusted for
+    // the current stop and the full unwinder is being used instead.
+    bool
+    IsUsingFullUnwinder () const
+    {
+        return m_full_unwinder_ap.get() != NULL;
+    }
+
+private:
+    struct Cursor
+    {
+        lldb::addr_t pc;    // Program counter
+        lldb::addr_t fp;    // Frame pointer
+        lldb::addr_t cfa;   // Canonical frame address (fp + 2 * address size)
+    };
+
+    std::vector<Cursor> m_cursors;
+    bool m_walked_chain;
+
+    // Created when the frame pointer chain can't be trusted
+    std::auto_ptr<lldb_private::Unwind> m_full_unwinder_ap;
+
+    // A chunk of stack memory that frame records are read from so
+    // we don't read memory once per frame
+    std::vector<uint8_t> m_stack_bytes;
+    lldb::addr_t m_stack_bytes_addr;
+
+    void
+    WalkFramePointerChain ();
+
+    bool
+    FrameZeroHasValidFramePointer (lldb::addr_t pc);
+
+    bool
+    IsCodeAddress (lldb::addr_t pc);
+
+    bool
+    ReadFrameRecord (lldb::addr_t fp,
+                     uint32_t addr_byte_size,
+                     lldb::ByteOrder byte_order,
+                     lldb::addr_t &caller_fp,
+                     lldb::addr_t &caller_pc);
+
+    void
+    UseFullUnwinder ();
+
+    //------------------------------------------------------------------
+    // For UnwindFramePointer only
+    //------------------------------------------------------------------
+    DISALLOW_COPY_AND_ASSIGN (UnwindFramePointer);
+};
+
+#endif  // lldb_UnwindFramePointer_h_
@@ -19,6 +19,7 @@
 #include "lldb/Core/Log.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Core/Timer.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
 
@@ -38,6 +39,7 @@ GDBRemoteCommunication::GDBRemoteCommunication() :
     m_supports_not_sending_acks (eLazyBoolCalculate),
     m_supports_thread_suffix (eLazyBoolCalculate),
     m_supports_qHostInfo (eLazyBoolCalculate),
+    m_supports_qSupported (eLazyBoolCalculate),
     m_supports_vCont_all (eLazyBoolCalculate),
     m_supports_vCont_any (eLazyBoolCalculate),
     m_supports_vCont_c (eLazyBoolCalculate),
@@ -58,7 +60,14 @@ GDBRemoteCommunication::GDBRemoteCommunication() :
     m_os(),
     m_vendor(),
     m_byte_order(lldb::endian::InlHostByteOrder()),
-    m_pointer_byte_size(0)
+    m_pointer_byte_size(0),
+    m_use_run_length_encoding (false),
+    m_rle_encoded_bytes (0),
+    m_rle_decoded_bytes (0),
+    m_packet_stats_mutex (Mutex::eMutexTypeNormal),
+    m_packet_stats (),
+    m_total_bytes_sent (0),
+    m_total_bytes_received (0)
 {
     m_rx_packet_listener.StartListeningForEvents(this,
                                                  Communication::eBroadcastBitPacketAvailable  |
@@ -119,10 +128,20 @@ GDBRemoteCommunication::SendNack ()
 
 bool
 GDBRemoteCommunication::GetSendAcks ()
+{
+    if (m_supports_not_sending_acks == eLazyBoolCalculate)
+        StartNoAckMode ();
+    return m_supports_not_sending_acks != eLazyBoolYes;
+}
+
+bool
+GDBRemoteCommunication::StartNoAckMode ()
 {
     if (m_supports_not_sending_acks == eLazyBoolCalculate)
     {
         StringExtractorGDBRemote response;
+        // The request and its response still use acks, so make sure we
+        // don't think acks are off while they are in flight.
         m_supports_not_sending_acks = eLazyBoolNo;
         if (SendPacketAndWaitForResponse("QStartNoAckMode", response, 1, false))
         {
@@ -130,7 +149,23 @@ GDBRemoteCommunication::GetSendAcks ()
                 m_supports_not_sending_acks = eLazyBoolYes;
         }
     }
-    return m_supports_not_sending_acks != eLazyBoolYes;
+    return m_supports_not_sending_acks == eLazyBoolYes;
+}
+
+void
+GDBRemoteCommunication::RequireAcks ()
+{
+    m_supports_not_sending_acks = eLazyBoolNo;
+}
+
+bool
+GDBRemoteCommunication::ConnectionURLIsReliable (const char *connect_url)
+{
+    if (connect_url == NULL)
+        return false;
+    return ::strstr (connect_url, "connect://") != NULL ||      // includes "unix-connect://"
+           ::strstr (connect_url, "listen://") != NULL ||
+           ::strstr (connect_url, "unix-accept://") != NULL;
 }
 
 void
@@ -139,6 +174,7 @@ GDBRemoteCommunication::ResetDiscoverableSettings()
     m_supports_not_sending_acks = eLazyBoolCalculate;
     m_supports_thread_suffix = eLazyBoolCalculate;
     m_supports_qHostInfo = eLazyBoolCalculate;
+    m_supports_qSupported = eLazyBoolCalculate;
     m_supports_vCont_c = eLazyBoolCalculate;
     m_supports_vCont_C = eLazyBoolCalculate;
     m_supports_vCont_s = eLazyBoolCalculate;
@@ -148,6 +184,7 @@ GDBRemoteCommunication::ResetDiscoverableSettings()
     m_vendor.Clear();
     m_byte_order = lldb::endian::InlHostByteOrder();
     m_pointer_byte_size = 0;
+    m_use_run_length_encoding = false;
 }
 
 
@@ -259,8 +296,14 @@ GDBRemoteCommunication::SendPacketAndWaitForResponse
 
     if (GetSequenceMutex (locker))
     {
+        const uint64_t start_time = Timer::GetMonotonicNanoSeconds();
         if (SendPacketNoLock (payload, strlen(payload)))
-            return WaitForPacketNoLock (response, &timeout_time);
+        {
+            const size_t response_size = WaitForPacketNoLock (response, &timeout_time);
+            if (response_size)
+                RecordResponse (payload[0], response_size, Timer::GetMonotonicNanoSeconds() - start_time);
+            return response_size;
+        }
     }
     else
     {
@@ -323,6 +366,106 @@ GDBRemoteCommunication::SendPacketAndWaitForResponse
     return 0;
 }
 
+size_t
+GDBRemoteCommunication::SendPacketsAndWaitForResponses
+(
+    const packet_collection &payloads,
+    std::vector<StringExtractorGDBRemote> &responses,
+    uint32_t timeout_seconds,
+    bool send_async
+)
+{
+    responses.clear();
+    if (payloads.empty())
+        return 0;
+
+    packet_collection::const_iterator pos, end = payloads.end();
+    Mutex::Locker locker;
+    if (GetSequenceMutex (locker) && IsConnected() && !GetSendAcks ())
+    {
+        // We don't need to wait for an ack after each packet, so keep up
+        // to kMaxOutstandingPackets of them on the wire and send another
+        // one each time a response comes back. The responses come back in
+        // the same order. Bounding the number in flight keeps the remote
+        // side's send buffer and our receive buffer from filling up while
+        // we are still writing.
+        LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+        const size_t num_packets = payloads.size();
+        std::vector<uint64_t> send_times (num_packets, 0);
+        responses.resize (num_packets);
+        packet_collection::const_iterator send_pos = payloads.begin();
+        size_t num_sent = 0;
+        bool send_failed = false;
+        size_t num_received;
+        for (num_received = 0, pos = payloads.begin(); num_received < num_packets; ++num_received, ++pos)
+        {
+            while (!send_failed && 
+                   num_sent < num_packets && 
+                   num_sent - num_received < kMaxOutstandingPackets)
+            {
+                send_times[num_sent] = Timer::GetMonotonicNanoSeconds();
+                if (SendPacketNoLock (send_pos->data(), send_pos->size()) != send_pos->size() + 4)
+                    send_failed = true;
+                else
+                {
+                    ++num_sent;
+                    ++send_pos;
+                }
+            }
+
+            if (num_received == num_sent)
+                break;
+
+            TimeValue timeout_time (TimeValue::Now());
+            timeout_time.OffsetWithSeconds (timeout_seconds);
+            const size_t response_size = WaitForPacketNoLock (responses[num_received], &timeout_time);
+            if (response_size == 0)
+            {
+                // The responses to this packet and the others we already
+                // sent may still be on their way. Read and discard them so
+                // the next packet doesn't get one of them as its response.
+                // If one doesn't show up in time we stop waiting, just like
+                // a single packet that timed out.
+                if (log)
+                    log->Printf ("error: no response to packet %zu of %zu, discarding the %zu outstanding responses", 
+                                 num_received + 1, 
+                                 num_packets, 
+                                 num_sent - num_received);
+                StringExtractorGDBRemote discarded_response;
+                for (size_t outstanding = num_sent - num_received; outstanding > 0; --outstanding)
+                {
+                    TimeValue discard_timeout_time (TimeValue::Now());
+                    discard_timeout_time.OffsetWithSeconds (timeout_seconds);
+                    if (WaitForPacketNoLock (discarded_response, &discard_timeout_time) == 0)
+                    {
+                        if (log)
+                            log->Printf ("error: gave up waiting for %zu responses", outstanding);
+                        break;
+                    }
+                }
+                break;
+            }
+            RecordResponse ((*pos)[0], response_size, Timer::GetMonotonicNanoSeconds() - send_times[num_received]);
+        }
+        if (send_failed && log)
+            log->Printf ("error: failed to send packet %zu of %zu", num_sent + 1, num_packets);
+        responses.resize (num_received);
+        return responses.size();
+    }
+
+    // Send the packets one at a time
+    for (pos = payloads.begin(); pos != end; ++pos)
+    {
+        responses.push_back (StringExtractorGDBRemote());
+        if (SendPacketAndWaitForResponse (pos->data(), pos->size(), responses.back(), timeout_seconds, send_async) == 0)
+        {
+            responses.pop_back();
+            break;
+        }
+    }
+    return responses.size();
+}
+
 //template<typename _Tp>
 //class ScopedValueChanger
 //{
@@ -568,6 +711,7 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
         size_t bytes_written = Write (packet.GetData(), packet.GetSize(), status, NULL);
         if (bytes_written == packet.GetSize())
         {
+            RecordPacketSent (payload, bytes_written);
             if (GetSendAcks ())
             {
                 if (GetAck (1) != '+')
@@ -743,10 +887,24 @@ GDBRemoteCommunication::WaitForPacketNoLock (StringExtractorGDBRemote &response,
                 if (log)
                     log->Printf ("read packet: %s", packet_data);
                 const size_t packet_size =  event_bytes->GetByteSize();
+                if (packet_size > 0)
+                {
+                    Mutex::Locker stats_locker (m_packet_stats_mutex);
+                    m_total_bytes_received += packet_size;
+                }
                 if (packet_data && packet_size > 0)
                 {
                     std::string &response_str = response.GetStringRef();
-                    if (packet_data[0] == '$')
+                    if (packet_data[0] == '$' && m_supports_not_sending_acks == eLazyBoolYes)
+                    {
+                        // Acks are off so there is nothing to check or
+                        // reply; just strip the '$' and "#xx" footer.
+                        if (packet_size >= 4 && packet_data[packet_size-3] == '#')
+                            response_str.assign (packet_data + 1, packet_size - 4);
+                        else
+                            ::fprintf (stderr, "Invalid packet: '%s'\n", packet_data);
+                    }
+                    else if (packet_data[0] == '$')
                     {
                         bool success = false;
                         if (packet_size < 4)
@@ -776,6 +934,27 @@ GDBRemoteCommunication::WaitForPacketNoLock (StringExtractorGDBRemote &response,
                     {
                         response_str.assign (packet_data, packet_size);
                     }
+
+                    // Run-length encoding is applied after the checksum
+                    // so only expand the response once that has been
+                    // checked.
+                    if (m_use_run_length_encoding)
+                    {
+                        const size_t encoded_size = response_str.size();
+                        const size_t growth = response.DecodeRunLengthEncoding();
+                        if (growth > 0)
+                        {
+                            Mutex::Locker stats_locker (m_packet_stats_mutex);
+                            m_rle_encoded_bytes += encoded_size;
+                            m_rle_decoded_bytes += encoded_size + growth;
+                            if (log)
+                                log->Printf ("read packet: run-length decoded %zu bytes from %zu (%.2f:1, %.2f:1 for all encoded packets)",
+                                             encoded_size + growth,
+                                             encoded_size,
+                                             (double)(encoded_size + growth) / encoded_size,
+                                             (double)m_rle_decoded_bytes / m_rle_encoded_bytes);
+                        }
+                    }
                     return response_str.size();
                 }
             }
@@ -807,6 +986,13 @@ GDBRemoteCommunication::AppendBytesToCache (const uint8_t *src, size_t src_len,
         switch (m_bytes[0])
         {
             case '+':       // Look for ack
+                // Once acks are off nobody waits for them, and a stray one
+                // would be mistaken for the response to the next packet.
+                if (m_supports_not_sending_acks == eLazyBoolYes)
+                    break;
+                end_idx = 1;
+                break;
+
             case '-':       // Look for cancel
             case '\x03':    // ^C to halt target
                 end_idx = 1;  // The command is one byte long...
@@ -856,6 +1042,112 @@ GDBRemoteCommunication::AppendBytesToCache (const uint8_t *src, size_t src_len,
     }
 }
 
+GDBRemoteCommunication::PacketStatistics::PacketStatistics () :
+    num_sent (0),
+    bytes_sent (0),
+    num_responses (0),
+    bytes_received (0),
+    total_usec (0),
+    min_usec (UINT64_MAX),
+    max_usec (0)
+{
+    ::memset (latency_histogram, 0, sizeof (latency_histogram));
+}
+
+void
+GDBRemoteCommunication::RecordPacketSent (const char *payload, size_t packet_size)
+{
+    const char packet_type = payload ? payload[0] : '\0';
+    Mutex::Locker locker (m_packet_stats_mutex);
+    PacketStatistics &stats = m_packet_stats[packet_type];
+    ++stats.num_sent;
+    stats.bytes_sent += packet_size;
+    m_total_bytes_sent += packet_size;
+}
+
+void
+GDBRemoteCommunication::RecordResponse (char packet_type, size_t response_size, uint64_t round_trip_nsec)
+{
+    const uint64_t usec = round_trip_nsec / 1000;
+    uint32_t bucket = 0;
+    while (bucket + 1 < kNumLatencyBuckets && (usec >> (bucket + 1)) != 0)
+        ++bucket;
+
+    Mutex::Locker locker (m_packet_stats_mutex);
+    PacketStatistics &stats = m_packet_stats[packet_type];
+    ++stats.num_responses;
+    stats.bytes_received += response_size;
+    stats.total_usec += usec;
+    if (usec < stats.min_usec)
+        stats.min_usec = usec;
+    if (usec > stats.max_usec)
+        stats.max_usec = usec;
+    ++stats.latency_histogram[bucket];
+}
+
+void
+GDBRemoteCommunication::DumpPacketStatistics (Stream &s)
+{
+    Mutex::Locker locker (m_packet_stats_mutex);
+    s.Printf ("bytes sent: %llu\nbytes received: %llu\n", m_total_bytes_sent, m_total_bytes_received);
+    if (m_rle_encoded_bytes > 0)
+        s.Printf ("run-length encoded responses: %llu bytes decoded from %llu (%.2f:1)\n",
+                  m_rle_decoded_bytes,
+                  m_rle_encoded_bytes,
+                  (double)m_rle_decoded_bytes / m_rle_encoded_bytes);
+
+    if (m_packet_stats.empty())
+        return;
+
+    s.Printf ("type       sent  bytes sent  responses  bytes received      avg us      min us      max us\n");
+    s.Printf ("---- ---------- ----------- ---------- --------------- ----------- ----------- -----------\n");
+    packet_stats_map::const_iterator pos, end = m_packet_stats.end();
+    for (pos = m_packet_stats.begin(); pos != end; ++pos)
+    {
+        const PacketStatistics &stats = pos->second;
+        if (::isprint ((unsigned char)pos->first))
+            s.Printf ("'%c' ", pos->first);
+        else
+            s.Printf ("%#.2x", (uint8_t)pos->first);
+        s.Printf (" %10llu %11llu %10llu %15llu", stats.num_sent, stats.bytes_sent, stats.num_responses, stats.bytes_received);
+        if (stats.num_responses > 0)
+            s.Printf (" %11llu %11llu %11llu", stats.total_usec / stats.num_responses, stats.min_usec, stats.max_usec);
+        s.EOL();
+    }
+
+    // The round trip time histograms
+    for (pos = m_packet_stats.begin(); pos != end; ++pos)
+    {
+        const PacketStatistics &stats = pos->second;
+        if (stats.num_responses == 0)
+            continue;
+        if (::isprint ((unsigned char)pos->first))
+            s.Printf ("\n'%c' round trips:\n", pos->first);
+        else
+            s.Printf ("\n%#.2x round trips:\n", (uint8_t)pos->first);
+        for (uint32_t bucket = 0; bucket < kNumLatencyBuckets; ++bucket)
+        {
+            if (stats.latency_histogram[bucket] == 0)
+                continue;
+            if (bucket + 1 < kNumLatencyBuckets)
+                s.Printf ("  < %10llu us: %llu\n", 1ull << (bucket + 1), stats.latency_histogram[bucket]);
+            else
+                s.Printf ("  >= %9llu us: %llu\n", 1ull << bucket, stats.latency_histogram[bucket]);
+        }
+    }
+}
+
+void
+GDBRemoteCommunication::ResetPacketStatistics ()
+{
+    Mutex::Locker locker (m_packet_stats_mutex);
+    m_packet_stats.clear();
+    m_total_bytes_sent = 0;
+    m_total_bytes_received = 0;
+    m_rle_encoded_bytes = 0;
+    m_rle_decoded_bytes = 0;
+}
+
 lldb::pid_t
 GDBRemoteCommunication::GetCurrentProcessID (uint32_t timeout_seconds)
 {
@@ -1008,6 +1300,40 @@ GDBRemoteCommunication::GetHostInfo ()
     return m_supports_qHostInfo == eLazyBoolYes;
 }
 
+bool
+GDBRemoteCommunication::GetRemoteQSupported ()
+{
+    if (m_supports_qSupported == eLazyBoolCalculate)
+    {
+        m_supports_qSupported = eLazyBoolNo;
+        m_use_run_length_encoding = false;
+
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse ("qSupported:rle+", response, 1, false))
+        {
+            if (response.IsUnsupportedPacket() || response.IsErrorPacket())
+                return false;
+
+            m_supports_qSupported = eLazyBoolYes;
+
+            // The response is a list of "feature+", "feature-" or
+            // "feature=value" items separated by semicolons
+            const std::string &features = response.GetStringRef();
+            size_t start = 0;
+            while (start < features.size())
+            {
+                size_t end = features.find (';', start);
+                if (end == std::string::npos)
+                    end = features.size();
+                if (features.compare (start, end - start, "rle+") == 0)
+                    m_use_run_length_encoding = true;
+                start = end + 1;
+            }
+        }
+    }
+    return m_supports_qSupported == eLazyBoolYes;
+}
+
 int
 GDBRemoteCommunication::SendAttach 
 (
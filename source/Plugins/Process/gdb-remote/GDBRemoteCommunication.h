@@ -13,7 +13,9 @@
 // C Includes
 // C++ Includes
 #include <list>
+#include <map>
 #include <string>
+#include <vector>
 
 // Other libraries and framework includes
 // Project includes
@@ -38,6 +40,16 @@ public:
     {
         eBroadcastBitRunPacketSent = kLoUserBroadcastBit
     };
+
+    enum
+    {
+        // The most packets SendPacketsAndWaitForResponses() has on the
+        // wire at once
+        kMaxOutstandingPackets = 16
+    };
+
+    typedef std::list<std::string> packet_collection;
+
     //------------------------------------------------------------------
     // Constructors and Destructors
     //------------------------------------------------------------------
@@ -66,6 +78,42 @@ public:
                                   uint32_t timeout_seconds,
                                   bool send_async);
 
+    //------------------------------------------------------------------
+    /// Send several independent packets and get their responses.
+    ///
+    /// When the remote server doesn't need acks, up to
+    /// kMaxOutstandingPackets packets are written before their responses
+    /// are read, and another one is sent as each response arrives, so the
+    /// batch costs about one round trip per kMaxOutstandingPackets packets
+    /// instead of one per packet. Otherwise the packets are sent one at a
+    /// time.
+    ///
+    /// @param[in] payloads
+    ///     The packet payloads to send, in order.
+    ///
+    /// @param[out] responses
+    ///     The responses, in the same order as \a payloads.
+    ///
+    /// @param[in] timeout_seconds
+    ///     The number of seconds to wait for each response.
+    ///
+    /// @param[in] send_async
+    ///     If true and another thread has the sequence mutex, interrupt
+    ///     the process to send each packet as SendPacketAndWaitForResponse
+    ///     does.
+    ///
+    /// @return
+    ///     The number of responses that were received. Responses are
+    ///     only missing at the end of \a responses. The responses to
+    ///     packets already sent after the first missing one are read and
+    ///     discarded.
+    //------------------------------------------------------------------
+    size_t
+    SendPacketsAndWaitForResponses (const packet_collection &payloads,
+                                    std::vector<StringExtractorGDBRemote> &responses,
+                                    uint32_t timeout_seconds,
+                                    bool send_async);
+
     lldb::StateType
     SendContinuePacketAndWaitForResponse (ProcessGDBRemote *process,
                                           const char *packet_payload,
@@ -280,9 +328,52 @@ public:
 
     bool
     GetHostInfo ();
+
+    //------------------------------------------------------------------
+    /// Tell the remote server which optional protocol features we
+    /// support with the "qSupported" packet, and find out which ones it
+    /// will use. Currently the only feature is "rle", which lets the
+    /// server run-length encode large responses.
+    //------------------------------------------------------------------
+    bool
+    GetRemoteQSupported ();
+
+    bool
+    GetRunLengthEncodingSupported ()
+    {
+        return m_use_run_length_encoding;
+    }
     
     bool
     GetSendAcks ();
+
+    //------------------------------------------------------------------
+    /// Ask the remote server to stop sending and expecting acks with
+    /// the "QStartNoAckMode" packet. Packet checksums are also neither
+    /// computed nor verified once acks are off.
+    ///
+    /// @return
+    ///     True if the server agreed and acks are now off.
+    //------------------------------------------------------------------
+    bool
+    StartNoAckMode ();
+
+    //------------------------------------------------------------------
+    /// Keep using acks and checksums for this connection. This is for
+    /// transports that can lose or corrupt data (e.g. serial lines),
+    /// where they are what detects and recovers from errors.
+    //------------------------------------------------------------------
+    void
+    RequireAcks ();
+
+    //------------------------------------------------------------------
+    /// Returns true if a connection made with \a connect_url can't
+    /// lose or corrupt data, so acks and checksums are unnecessary.
+    /// Sockets are reliable; files (which include serial devices)
+    /// are not.
+    //------------------------------------------------------------------
+    static bool
+    ConnectionURLIsReliable (const char *connect_url);
     
     bool
     GetSupportsThreadSuffix ();
@@ -299,8 +390,50 @@ public:
         return GetVContSupported ('a');
     }
 
+    //------------------------------------------------------------------
+    /// Dump the packet statistics: the bytes sent and received, and for
+    /// each packet type (the first character of the packet) the number
+    /// of packets, the bytes in the packets and their responses, and a
+    /// histogram of the round trip times. Continue packets are counted
+    /// but have no round trip time since they wait for the process.
+    //------------------------------------------------------------------
+    void
+    DumpPacketStatistics (lldb_private::Stream &s);
+
+    void
+    ResetPacketStatistics ();
+
 protected:
-    typedef std::list<std::string> packet_collection;
+    enum
+    {
+        // Bucket N counts round trips of at least 2^N and less than
+        // 2^(N+1) microseconds; the last bucket counts all longer ones.
+        kNumLatencyBuckets = 24
+    };
+
+    struct PacketStatistics
+    {
+        PacketStatistics ();
+
+        uint64_t num_sent;
+        uint64_t bytes_sent;
+        uint64_t num_responses;
+        uint64_t bytes_received;
+        uint64_t total_usec;
+        uint64_t min_usec;
+        uint64_t max_usec;
+        uint64_t latency_histogram[kNumLatencyBuckets];
+    };
+
+    typedef std::map<char, PacketStatistics> packet_stats_map;
+
+    void
+    RecordPacketSent (const char *payload, size_t packet_size);
+
+    void
+    RecordResponse (char packet_type,
+                    size_t response_size,
+                    uint64_t round_trip_nsec);
 
     size_t
     SendPacketNoLock (const char *payload, 
@@ -325,6 +458,7 @@ protected:
     lldb::LazyBool m_supports_not_sending_acks;
     lldb::LazyBool m_supports_thread_suffix;
     lldb::LazyBool m_supports_qHostInfo;
+    lldb::LazyBool m_supports_qSupported;
     lldb::LazyBool m_supports_vCont_all;
     lldb::LazyBool m_supports_vCont_any;
     lldb::LazyBool m_supports_vCont_c;
@@ -351,6 +485,13 @@ protected:
     lldb_private::ConstString m_vendor; // Results from the qHostInfo call
     lldb::ByteOrder m_byte_order;       // Results from the qHostInfo call
     uint32_t m_pointer_byte_size;       // Results from the qHostInfo call
+    bool m_use_run_length_encoding;     // Results from the qSupported call
+    uint64_t m_rle_encoded_bytes;       // The total size of the run-length encoded responses we received...
+    uint64_t m_rle_decoded_bytes;       // ...and their total size once decoded
+    lldb_private::Mutex m_packet_stats_mutex;   // Protects the run-length encoding totals and the members below
+    packet_stats_map m_packet_stats;            // Statistics for each packet type
+    uint64_t m_total_bytes_sent;
+    uint64_t m_total_bytes_received;
     
     
 private:
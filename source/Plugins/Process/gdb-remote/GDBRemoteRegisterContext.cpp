@@ -11,6 +11,8 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 #include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/DataExtractor.h"
@@ -204,6 +206,34 @@ GDBRemoteRegisterContext::PrivateSetRegisterValue (uint32_t reg, StringExtractor
     return success;
 }
 
+// Fill in "regs" with "reg" followed by the other registers in the same
+// register set that aren't valid yet.
+void
+GDBRemoteRegisterContext::GetInvalidRegistersInSameSet (uint32_t reg, std::vector<uint32_t> &regs)
+{
+    regs.clear();
+    regs.push_back (reg);
+
+    const size_t num_sets = GetRegisterSetCount ();
+    for (size_t set_idx = 0; set_idx < num_sets; ++set_idx)
+    {
+        const RegisterSet *reg_set = GetRegisterSet (set_idx);
+        if (reg_set == NULL || reg_set->registers == NULL)
+            continue;
+
+        const uint32_t *set_regs_end = reg_set->registers + reg_set->num_registers;
+        if (std::find (reg_set->registers, set_regs_end, reg) == set_regs_end)
+            continue;
+
+        for (size_t i = 0; i < reg_set->num_registers; ++i)
+        {
+            const uint32_t set_reg = reg_set->registers[i];
+            if (set_reg != reg && set_reg < m_reg_valid.size() && !m_reg_valid[set_reg])
+                regs.push_back (set_reg);
+        }
+        break;
+    }
+}
 
 bool
 GDBRemoteRegisterContext::ReadRegisterBytes (uint32_t reg, DataExtractor &data)
@@ -242,14 +272,26 @@ GDBRemoteRegisterContext::ReadRegisterBytes (uint32_t reg, DataExtractor &data)
                 }
                 else
                 {
-                    // Get each register individually
-                    if (thread_suffix_supported)
-                        packet_len = ::snprintf (packet, sizeof(packet), "p%x;thread:%4.4x;", reg, m_thread.GetID());
-                    else
-                        packet_len = ::snprintf (packet, sizeof(packet), "p%x", reg);
-                    assert (packet_len < (sizeof(packet) - 1));
-                    if (gdb_comm.SendPacketAndWaitForResponse(packet, response, 1, false))
-                        PrivateSetRegisterValue (reg, response);
+                    // Get each register individually. The rest of the
+                    // register set is usually wanted next, so ask for all
+                    // of its registers we don't have yet in one batch.
+                    std::vector<uint32_t> regs;
+                    GetInvalidRegistersInSameSet (reg, regs);
+                    GDBRemoteCommunication::packet_collection packets;
+                    for (size_t i = 0; i < regs.size(); ++i)
+                    {
+                        if (thread_suffix_supported)
+                            packet_len = ::snprintf (packet, sizeof(packet), "p%x;thread:%4.4x;", regs[i], m_thread.GetID());
+                        else
+                            packet_len = ::snprintf (packet, sizeof(packet), "p%x", regs[i]);
+                        assert (packet_len < (sizeof(packet) - 1));
+                        packets.push_back (std::string (packet, packet_len));
+                    }
+
+                    std::vector<StringExtractorGDBRemote> responses;
+                    const size_t num_responses = gdb_comm.SendPacketsAndWaitForResponses (packets, responses, 1, false);
+                    for (size_t i = 0; i < num_responses; ++i)
+                        PrivateSetRegisterValue (regs[i], responses[i]);
                 }
             }
         }
@@ -230,6 +230,9 @@ protected:
 
     bool
     PrivateSetRegisterValue (uint32_t reg, StringExtractor &response);
+
+    void
+    GetInvalidRegistersInSameSet (uint32_t reg, std::vector<uint32_t> &regs);
     
     void
     SetAllRegisterValid (bool b);
@@ -166,14 +166,31 @@ ProcessGDBRemote::GetPluginVersion()
 void
 ProcessGDBRemote::GetPluginCommandHelp (const char *command, Stream *strm)
 {
-    strm->Printf("TODO: fill this in\n");
+    strm->Printf("packet-stats [dump]  -- Show the packet counts, byte counts and round trip times for each packet type.\n");
+    strm->Printf("packet-stats reset   -- Clear the packet statistics.\n");
 }
 
 Error
 ProcessGDBRemote::ExecutePluginCommand (Args &command, Stream *strm)
 {
     Error error;
-    error.SetErrorString("No plug-in commands are currently supported.");
+    const size_t argc = command.GetArgumentCount();
+    const char *sub_command = command.GetArgumentAtIndex(0);
+    if (sub_command && ::strcasecmp (sub_command, "packet-stats") == 0)
+    {
+        const char *action = command.GetArgumentAtIndex(1);
+        if (argc == 1 || (argc == 2 && ::strcasecmp (action, "dump") == 0))
+            m_gdb_comm.DumpPacketStatistics (*strm);
+        else if (argc == 2 && ::strcasecmp (action, "reset") == 0)
+            m_gdb_comm.ResetPacketStatistics ();
+        else
+            error.SetErrorString("usage: packet-stats [dump | reset]");
+    }
+    else
+    {
+        error.SetErrorStringWithFormat("unknown command '%s'", sub_command ? sub_command : "");
+        GetPluginCommandHelp (NULL, strm);
+    }
     return error;
 }
 
@@ -620,7 +637,13 @@ ProcessGDBRemote::ConnectToDebugserver (const char *connect_url)
                                                                       false);
         
         m_gdb_comm.ResetDiscoverableSettings();
-        m_gdb_comm.GetSendAcks ();
+        // Acks and checksums only guard against lost or corrupted bytes,
+        // so turn them off up front on connections that can't have either
+        if (GDBRemoteCommunication::ConnectionURLIsReliable (connect_url))
+            m_gdb_comm.StartNoAckMode ();
+        else
+            m_gdb_comm.RequireAcks ();
+        m_gdb_comm.GetRemoteQSupported ();
         m_gdb_comm.GetThreadSuffixSupported ();
         m_gdb_comm.GetHostInfo ();
         m_gdb_comm.GetVContSupported ('c');
@@ -1542,10 +1565,11 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
 {
     if (size > m_max_memory_size)
     {
-        // Keep memory read sizes down to a sane limit. This function will be
-        // called multiple times in order to complete the task by 
-        // lldb_private::Process so it is ok to do this.
-        size = m_max_memory_size;
+        // Keep memory read sizes down to a sane limit by splitting the read
+        // into chunks. All of their addresses are known up front, so the
+        // requests are pipelined (a bounded number at a time) instead of
+        // paying for a round trip per chunk.
+        return DoReadMemoryInChunks (addr, buf, size, error);
     }
 
     char packet[64];
@@ -1573,6 +1597,55 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
     return 0;
 }
 
+size_t
+ProcessGDBRemote::DoReadMemoryInChunks (addr_t addr, void *buf, size_t size, Error &error)
+{
+    GDBRemoteCommunication::packet_collection packets;
+    char packet[64];
+    for (size_t offset = 0; offset < size; offset += m_max_memory_size)
+    {
+        const size_t chunk_size = std::min<size_t> (size - offset, m_max_memory_size);
+        const int packet_len = ::snprintf (packet, sizeof(packet), "m%llx,%zx", (uint64_t)(addr + offset), chunk_size);
+        assert (packet_len + 1 < sizeof(packet));
+        packets.push_back (std::string (packet, packet_len));
+    }
+
+    std::vector<StringExtractorGDBRemote> responses;
+    m_gdb_comm.SendPacketsAndWaitForResponses (packets, responses, 2, true);
+
+    // Stop at the first chunk we couldn't read so that we return the
+    // number of contiguous bytes that were read, like a single 'm' packet
+    uint8_t *dst = (uint8_t *)buf;
+    size_t bytes_read = 0;
+    GDBRemoteCommunication::packet_collection::const_iterator packet_pos = packets.begin();
+    for (size_t i = 0; i < responses.size(); ++i, ++packet_pos)
+    {
+        StringExtractorGDBRemote &response = responses[i];
+        const size_t chunk_size = std::min<size_t> (size - bytes_read, m_max_memory_size);
+        if (!response.IsNormalPacket())
+        {
+            if (response.IsErrorPacket())
+                error.SetErrorStringWithFormat("gdb remote returned an error: %s", response.GetStringRef().c_str());
+            else if (response.IsUnsupportedPacket())
+                error.SetErrorStringWithFormat("'%s' packet unsupported", packet_pos->c_str());
+            else
+                error.SetErrorStringWithFormat("unexpected response to '%s': '%s'", packet_pos->c_str(), response.GetStringRef().c_str());
+            break;
+        }
+
+        const size_t chunk_bytes_read = response.GetHexBytes(dst + bytes_read, chunk_size, '\xdd');
+        bytes_read += chunk_bytes_read;
+        if (chunk_bytes_read < chunk_size)
+            break;
+    }
+
+    if (bytes_read > 0)
+        error.Clear();
+    else if (responses.empty())
+        error.SetErrorStringWithFormat("failed to sent packet: '%s'", packets.front().c_str());
+    return bytes_read;
+}
+
 size_t
 ProcessGDBRemote::DoWriteMemory (addr_t addr, const void *buf, size_t size, Error &error)
 {
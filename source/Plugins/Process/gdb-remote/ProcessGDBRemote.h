@@ -289,6 +289,9 @@ protected:
     uint32_t
     UpdateThreadListIfNeeded ();
 
+    size_t
+    DoReadMemoryInChunks (lldb::addr_t addr, void *buf, size_t size, lldb_private::Error &error);
+
     lldb_private::Error
     StartDebugserverProcess (const char *debugserver_url,   // The connection string to use in the spawned debugserver ("localhost:1234" or "/dev/tty...")
                              char const *inferior_argv[],
@@ -19,7 +19,10 @@ DWARFAbbreviationDeclaration::DWARFAbbreviationDeclaration() :
     m_code  (InvalidCode),
     m_tag   (0),
     m_has_children (0),
-    m_attributes()
+    m_attributes(),
+    m_fixed_byte_size (0),
+    m_num_addr_sized_forms (0),
+    m_variable_forms()
 {
 }
 
@@ -27,7 +30,10 @@ DWARFAbbreviationDeclaration::DWARFAbbreviationDeclaration(dw_tag_t tag, uint8_t
     m_code  (InvalidCode),
     m_tag   (tag),
     m_has_children (has_children),
-    m_attributes()
+    m_attributes(),
+    m_fixed_byte_size (0),
+    m_num_addr_sized_forms (0),
+    m_variable_forms()
 {
 }
 
@@ -58,17 +64,83 @@ DWARFAbbreviationDeclaration::Extract(const DataExtractor& data, uint32_t* offse
                 break;
         }
 
+        UpdateSkipInfo();
         return m_tag != 0;
     }
     else
     {
         m_tag = 0;
         m_has_children = 0;
+        UpdateSkipInfo();
     }
 
     return false;
 }
 
+//----------------------------------------------------------------------
+// UpdateSkipInfo
+//
+// Precompute how to skip over the attribute values of a DIE that uses
+// this abbreviation. All fixed sized values are added up (address sized
+// forms are counted separately since the size depends on the compile
+// unit) so only the variable sized forms need to be looked at.
+//----------------------------------------------------------------------
+void
+DWARFAbbreviationDeclaration::UpdateSkipInfo()
+{
+    m_fixed_byte_size = 0;
+    m_num_addr_sized_forms = 0;
+    m_variable_forms.clear();
+
+    VariableForm variable_form = { 0, 0, 0 };
+    const uint32_t num_attributes = m_attributes.size();
+    for (uint32_t i = 0; i < num_attributes; ++i)
+    {
+        const dw_form_t form = m_attributes[i].get_form();
+        uint32_t form_size = 0;
+        switch (form)
+        {
+        case DW_FORM_addr:
+        case DW_FORM_ref_addr:
+            ++m_num_addr_sized_forms;
+            ++variable_form.num_addr_sized_forms;
+            continue;
+
+        case DW_FORM_data1:
+        case DW_FORM_flag:
+        case DW_FORM_ref1:
+            form_size = 1;
+            break;
+
+        case DW_FORM_data2:
+        case DW_FORM_ref2:
+            form_size = 2;
+            break;
+
+        case DW_FORM_strp:
+        case DW_FORM_data4:
+        case DW_FORM_ref4:
+            form_size = 4;
+            break;
+
+        case DW_FORM_data8:
+        case DW_FORM_ref8:
+            form_size = 8;
+            break;
+
+        default:
+            // Blocks, strings, LEB128 values and indirect forms
+            variable_form.form = form;
+            m_variable_forms.push_back (variable_form);
+            variable_form.fixed_byte_size = 0;
+            variable_form.num_addr_sized_forms = 0;
+            continue;
+        }
+        m_fixed_byte_size += form_size;
+        variable_form.fixed_byte_size += form_size;
+    }
+}
+
 
 void
 DWARFAbbreviationDeclaration::Dump(Stream *s)  const
@@ -134,6 +206,7 @@ DWARFAbbreviationDeclaration::CopyExcludingAddressAttributes(const DWARFAbbrevia
             break;
         }
     }
+    UpdateSkipInfo();
 }
 
 void
@@ -168,6 +241,7 @@ DWARFAbbreviationDeclaration::CopyChangingStringToStrp(
         else
             m_attributes.push_back(DWARFAttribute(attr, form));
     }
+    UpdateSkipInfo();
 }
 
 
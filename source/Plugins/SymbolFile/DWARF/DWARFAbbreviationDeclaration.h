@@ -19,6 +19,22 @@ class DWARFAbbreviationDeclaration
 {
 public:
     enum { InvalidCode = 0 };
+
+    //------------------------------------------------------------------
+    // A variable sized form along with the fixed sized data that
+    // precedes it (since the previous variable sized form). Lets a DIE
+    // be skipped by adding up the fixed sized data and only decoding
+    // the variable sized forms.
+    //------------------------------------------------------------------
+    struct VariableForm
+    {
+        uint32_t    fixed_byte_size;        // Bytes of fixed sized forms that precede this form, excluding address sized forms
+        uint16_t    num_addr_sized_forms;   // Number of address sized forms that precede this form
+        dw_form_t   form;                   // The variable sized form
+    };
+    typedef std::vector<VariableForm> VariableFormColl;
+
+
                     DWARFAbbreviationDeclaration();
 
                     // For hand crafting an abbreviation declaration
@@ -26,6 +42,7 @@ public:
     void            AddAttribute(const DWARFAttribute& attr)
                     {
                         m_attributes.push_back(attr);
+                        UpdateSkipInfo();
                     }
 
     dw_uleb128_t    Code() const { return m_code; }
@@ -71,11 +88,23 @@ public:
     bool            operator == (const DWARFAbbreviationDeclaration& rhs) const;
 //  DWARFAttribute::collection& Attributes() { return m_attributes; }
     const DWARFAttribute::collection& Attributes() const { return m_attributes; }
+
+                    // Returns true if all attribute values for this abbreviation
+                    // have a fixed size, so a DIE can be skipped with a single add.
+    bool            HasFixedByteSize() const { return m_variable_forms.empty(); }
+                    // The number of bytes taken up by all fixed sized attribute values
+    uint32_t        GetFixedByteSize(uint8_t addr_size) const { return m_fixed_byte_size + m_num_addr_sized_forms * addr_size; }
+    const VariableFormColl& VariableForms() const { return m_variable_forms; }
 protected:
+    void            UpdateSkipInfo();
+
     dw_uleb128_t        m_code;
     dw_tag_t            m_tag;
     uint8_t             m_has_children;
     DWARFAttribute::collection m_attributes;
+    uint32_t            m_fixed_byte_size;      // Size of all fixed sized attribute values, excluding address sized forms
+    uint16_t            m_num_addr_sized_forms; // Number of DW_FORM_addr and DW_FORM_ref_addr attribute values
+    VariableFormColl    m_variable_forms;       // All variable sized forms in attribute order
 };
 
 #endif  // liblldb_DWARFAbbreviationDeclaration_h_
@@ -172,7 +172,17 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
     // we were told to parse
     const DataExtractor& debug_info_data = m_dwarf2Data->get_debug_info_data();
 
+    // The average bytes per DIE entry has been seen to be around 14-20
+    // so pre-reserve the memory for all of our DIE entries up front
+    // based on the compile unit length. Search forward for "Compute
+    // average bytes per DIE" to see #if'ed out code that does that
+    // determination. This is done on every full extraction since
+    // ClearDIEs() releases the memory once the DIEs have been indexed.
+    if (!cu_die_only)
+        m_die_array.reserve(GetDebugInfoSize() / 14);
+
     const uint8_t *fixed_form_sizes = DWARFFormValue::GetFixedFormSizesForAddressSize (GetAddressByteSize());
+    bool done = false;
     while (die.FastExtract (debug_info_data, this, fixed_form_sizes, &offset))
     {
 //        if (log)
@@ -204,11 +214,10 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
             AddDIE (die);
         }
 
-        const DWARFAbbreviationDeclaration* abbrDecl = die.GetAbbreviationDeclarationPtr();
-        if (abbrDecl)
+        if (!die.IsNULL())
         {
             // Normal DIE
-            if (abbrDecl->HasChildren())
+            if (die.HasChildren())
                 ++depth;
         }
         else
@@ -217,7 +226,10 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
             if (depth > 0)
                 --depth;
             if (depth == 0)
+            {
+                done = true;
                 break;  // We are done with this compile unit!
+            }
         }
 
         if (offset > GetNextCompileUnitOffset())
@@ -229,9 +241,25 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
                 objfile->GetFileSpec().GetPath(path, sizeof(path));
             }
             fprintf (stderr, "warning: DWARF compile unit extends beyond its bounds cu 0x%8.8x at 0x%8.8x in '%s'\n", GetOffset(), offset, path);
+            done = true;
             break;
         }
     }
+
+    // FastExtract() fails on a DIE whose abbreviation code isn't in this
+    // compile unit's abbreviation set, or whose attribute data can't be
+    // skipped. Say so, otherwise all the DIEs after it silently go missing.
+    if (!done && offset < GetNextCompileUnitOffset())
+    {
+        char path[PATH_MAX];
+        path[0] = '\0';
+        ObjectFile *objfile = m_dwarf2Data->GetObjectFile();
+        if (objfile)
+            objfile->GetFileSpec().GetPath(path, sizeof(path));
+        uint32_t abbr_offset = offset;
+        const dw_uleb128_t abbr_code = debug_info_data.GetULEB128 (&abbr_offset);
+        fprintf (stderr, "error: DWARF compile unit 0x%8.8x has a DIE at 0x%8.8x (abbreviation code %u) that can't be parsed in '%s', the remaining DIEs in this compile unit are ignored\n", GetOffset(), offset, abbr_code, path);
+    }
     SetDIERelations();
     return m_die_array.size();
 }
@@ -419,12 +447,10 @@ DWARFCompileUnit::SetDIERelations()
         // safely access the next die in the array.
         DWARFDebugInfoEntry* next_die = curr_die + 1;
 
-        const DWARFAbbreviationDeclaration* curr_die_abbrev = curr_die->GetAbbreviationDeclarationPtr();
-
-        if (curr_die_abbrev)
+        if (!curr_die->IsNULL())
         {
             // Normal DIE
-            if (curr_die_abbrev->HasChildren())
+            if (curr_die->HasChildren())
                 next_die->SetParent(curr_die);
             else
                 curr_die->SetSibling(next_die);
@@ -41,6 +41,7 @@ public:
     uint32_t    GetLength() const { return m_length; }
     uint16_t    GetVersion() const { return m_version; }
     const DWARFAbbreviationDeclarationSet*  GetAbbreviations() const { return m_abbrevs; }
+    SymbolFileDWARF*    GetSymbolFileDWARF () const { return m_dwarf2Data; }
     dw_offset_t GetAbbrevOffset() const;
     uint8_t     GetAddressByteSize() const { return m_addr_size; }
     dw_addr_t   GetBaseAddress() const { return m_base_addr; }
@@ -76,19 +77,9 @@ public:
     void
     AddDIE(DWARFDebugInfoEntry& die)
     {
-        // The average bytes per DIE entry has been seen to be
-        // around 14-20 so lets pre-reserve the needed memory for
-        // our DIE entries accordingly. Search forward for "Compute
-        // average bytes per DIE" to see #if'ed out code that does
-        // that determination.
-
-        // Only reserve the memory if we are adding children of
-        // the main compile unit DIE. The compile unit DIE is always
-        // the first entry, so if our size is 1, then we are adding
-        // the first compile unit child DIE and should reserve
-        // the memory.
-        if (m_die_array.empty())
-            m_die_array.reserve(GetDebugInfoSize() / 14);
+        // ExtractDIEsIfNeeded() reserves the memory for all DIEs in
+        // this compile unit up front, so this won't need to grow
+        // the array in the common case.
         m_die_array.push_back(die);
     }
 
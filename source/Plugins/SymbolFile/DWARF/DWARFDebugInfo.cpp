@@ -499,7 +499,7 @@ VerifyCallback
     if (die)
     {
     //  die->Dump(dwarf2Data, cu, f);
-        const DWARFAbbreviationDeclaration* abbrevDecl = die->GetAbbreviationDeclarationPtr();
+        const DWARFAbbreviationDeclaration* abbrevDecl = die->GetAbbreviationDeclarationPtr(cu);
         // We have a DIE entry
         if (abbrevDecl)
         {
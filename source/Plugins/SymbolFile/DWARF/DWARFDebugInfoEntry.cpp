@@ -10,6 +10,7 @@
 #include "DWARFDebugInfoEntry.h"
 
 #include <assert.h>
+#include <string.h>
 
 #include <algorithm>
 
@@ -101,6 +102,74 @@ DWARFDebugInfoEntry::Attributes::FormValueAsUnsignedAtIndex(SymbolFileDWARF* dwa
 }
 
 
+//----------------------------------------------------------------------
+// SetAbbreviationDeclaration
+//
+// DIEs don't keep a pointer to their abbreviation declaration, they
+// keep the abbreviation code which is an index into the abbreviation
+// set of the compile unit that owns them. The tag and children flag
+// are cached alongside so the common queries don't need the compile
+// unit. Passing an abbreviation code of zero marks a NULL entry.
+// Codes too large for the packed field are stored as DIE_ABBR_IDX_LARGE
+// and GetAbbreviationDeclarationPtr() decodes them again from the
+// .debug_info, which only costs anything for compile units that have
+// that many abbreviations.
+//----------------------------------------------------------------------
+bool
+DWARFDebugInfoEntry::SetAbbreviationDeclaration
+(
+    dw_uleb128_t abbr_code,
+    const DWARFAbbreviationDeclaration* abbrevDecl
+)
+{
+    if (abbr_code == 0 || abbrevDecl == NULL)
+    {
+        m_abbr_idx = 0;
+        m_has_children = 0;
+        m_tag = 0;
+        // Only a zero abbreviation code is a valid NULL entry
+        return abbr_code == 0;
+    }
+    m_abbr_idx = abbr_code < DIE_ABBR_IDX_LARGE ? abbr_code : DIE_ABBR_IDX_LARGE;
+    m_has_children = abbrevDecl->HasChildren();
+    m_tag = abbrevDecl->Tag();
+    return true;
+}
+
+//----------------------------------------------------------------------
+// GetAbbreviationDeclarationPtr
+//----------------------------------------------------------------------
+const DWARFAbbreviationDeclaration*
+DWARFDebugInfoEntry::GetAbbreviationDeclarationPtr (const DWARFCompileUnit* cu) const
+{
+    if (m_abbr_idx && cu)
+    {
+        const DWARFAbbreviationDeclarationSet* abbrev_set = cu->GetAbbreviations();
+        if (abbrev_set)
+        {
+            dw_uleb128_t abbr_code = m_abbr_idx;
+            if (abbr_code == DIE_ABBR_IDX_LARGE)
+            {
+                uint32_t offset = m_offset;
+                abbr_code = cu->GetSymbolFileDWARF()->get_debug_info_data().GetULEB128 (&offset);
+            }
+            return abbrev_set->GetAbbreviationDeclaration (abbr_code);
+        }
+    }
+    return NULL;
+}
+
+//----------------------------------------------------------------------
+// NumAttributes
+//----------------------------------------------------------------------
+uint32_t
+DWARFDebugInfoEntry::NumAttributes (const DWARFCompileUnit* cu) const
+{
+    const DWARFAbbreviationDeclaration* abbrevDecl = GetAbbreviationDeclarationPtr (cu);
+    if (abbrevDecl)
+        return abbrevDecl->NumAttributes();
+    return 0;
+}
 
 bool
 DWARFDebugInfoEntry::FastExtract
@@ -121,26 +190,45 @@ DWARFDebugInfoEntry::FastExtract
     {
         uint32_t offset = *offset_ptr;
 
-        m_abbrevDecl = cu->GetAbbreviations()->GetAbbreviationDeclaration(abbrCode);
+        const DWARFAbbreviationDeclaration* abbrevDecl = cu->GetAbbreviations()->GetAbbreviationDeclaration(abbrCode);
+        if (!SetAbbreviationDeclaration (abbrCode, abbrevDecl))
+        {
+            *offset_ptr = m_offset;
+            return false;
+        }
         
-        // Skip all data in the .debug_info for the attributes
-        const uint32_t numAttributes = m_abbrevDecl->NumAttributes();
-        register uint32_t i;
-        register dw_form_t form;
-        for (i=0; i<numAttributes; ++i)
+        // Skip all data in the .debug_info for the attributes. The fixed
+        // sized attribute values were all added up when the abbreviation
+        // was parsed, so most DIEs are skipped with a single add.
+        const uint8_t addr_size = cu->GetAddressByteSize();
+        uint32_t fixed_bytes_left = abbrevDecl->GetFixedByteSize (addr_size);
+        if (!abbrevDecl->HasFixedByteSize())
         {
-            form = m_abbrevDecl->GetFormByIndexUnchecked(i);
-
-            const uint8_t fixed_skip_size = fixed_form_sizes [form];
-            if (fixed_skip_size)
-                offset += fixed_skip_size;
-            else
+            const uint8_t *data_start = debug_info_data.GetDataStart();
+            const uint8_t *data_end = debug_info_data.GetDataEnd();
+            const DWARFAbbreviationDeclaration::VariableFormColl &variable_forms = abbrevDecl->VariableForms();
+            const size_t num_variable_forms = variable_forms.size();
+            for (size_t i=0; i<num_variable_forms; ++i)
             {
+                const DWARFAbbreviationDeclaration::VariableForm &variable_form = variable_forms[i];
+                // Skip the fixed sized data that precedes this form
+                const uint32_t fixed_skip_size = variable_form.fixed_byte_size + variable_form.num_addr_sized_forms * addr_size;
+                offset += fixed_skip_size;
+                fixed_bytes_left -= fixed_skip_size;
+
+                register dw_form_t form = variable_form.form;
                 bool form_is_indirect = false;
                 do
                 {
                     form_is_indirect = false;
                     register uint32_t form_size = 0;
+                    const uint8_t *src = data_start + offset;
+                    if (src >= data_end)
+                    {
+                        *offset_ptr = m_offset;
+                        return false;
+                    }
+
                     switch (form)
                     {
                     // Blocks if inlined data that have a length field and the data bytes
@@ -152,51 +240,35 @@ DWARFDebugInfoEntry::FastExtract
 
                     // Inlined NULL terminated C-strings
                     case DW_FORM_string     :
-                        debug_info_data.GetCStr (&offset);
-                        break;
-
-                    // Compile unit address sized values
-                    case DW_FORM_addr       :
-                    case DW_FORM_ref_addr   :
-                        form_size = cu->GetAddressByteSize();
-                        break;
-
-                    // 1 byte values
-                    case DW_FORM_data1      :
-                    case DW_FORM_flag       :
-                    case DW_FORM_ref1       :
-                        form_size = 1;
-                        break;
-
-                    // 2 byte values
-                    case DW_FORM_data2      :
-                    case DW_FORM_ref2       :
-                        form_size = 2;
-                        break;
-
-                    // 4 byte values
-                    case DW_FORM_strp       :
-                    case DW_FORM_data4      :
-                    case DW_FORM_ref4       :
-                        form_size = 4;
-                        break;
-
-                    // 8 byte values
-                    case DW_FORM_data8      :
-                    case DW_FORM_ref8       :
-                        form_size = 8;
+                        {
+                            const uint8_t *nul = (const uint8_t *)::memchr (src, 0, data_end - src);
+                            if (nul == NULL)
+                            {
+                                *offset_ptr = m_offset;
+                                return false;
+                            }
+                            offset += nul + 1 - src;
+                        }
                         break;
 
-                    // signed or unsigned LEB 128 values
+                    // signed or unsigned LEB128 values
                     case DW_FORM_sdata      :
                     case DW_FORM_udata      :
                     case DW_FORM_ref_udata  :
-                        debug_info_data.Skip_LEB128 (&offset);
+                        while (src < data_end && (*src++ & 0x80))
+                            /* skip */;
+                        offset = src - data_start;
                         break;
 
                     case DW_FORM_indirect   :
                         form_is_indirect = true;
                         form = debug_info_data.GetULEB128 (&offset);
+                        // The actual form might be a fixed sized one
+                        if (form < DW_FORM_indirect && fixed_form_sizes[form])
+                        {
+                            form_size = fixed_form_sizes[form];
+                            form_is_indirect = false;
+                        }
                         break;
 
                     default:
@@ -208,12 +280,13 @@ DWARFDebugInfoEntry::FastExtract
                 } while (form_is_indirect);
             }
         }
+        offset += fixed_bytes_left;
         *offset_ptr = offset;
         return true;
     }
     else
     {
-        m_abbrevDecl = NULL;
+        SetAbbreviationDeclaration (0, NULL);
         return true;    // NULL debug tag entry
     }
 
@@ -250,24 +323,24 @@ DWARFDebugInfoEntry::Extract
 
         if (abbrCode)
         {
-            m_abbrevDecl = cu->GetAbbreviations()->GetAbbreviationDeclaration(abbrCode);
+            const DWARFAbbreviationDeclaration* abbrevDecl = cu->GetAbbreviations()->GetAbbreviationDeclaration(abbrCode);
 
-            if (m_abbrevDecl)
+            if (SetAbbreviationDeclaration (abbrCode, abbrevDecl))
             {
-                dw_tag_t tag = m_abbrevDecl->Tag();
+                dw_tag_t tag = m_tag;
 
                 bool isCompileUnitTag = tag == DW_TAG_compile_unit;
                 if (cu && isCompileUnitTag)
                     ((DWARFCompileUnit*)cu)->SetBaseAddress(0);
 
                 // Skip all data in the .debug_info for the attributes
-                const uint32_t numAttributes = m_abbrevDecl->NumAttributes();
+                const uint32_t numAttributes = abbrevDecl->NumAttributes();
                 uint32_t i;
                 dw_attr_t attr;
                 dw_form_t form;
                 for (i=0; i<numAttributes; ++i)
                 {
-                    m_abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
+                    abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
 
                     if (isCompileUnitTag && ((attr == DW_AT_entry_pc) || (attr == DW_AT_low_pc)))
                     {
@@ -359,7 +432,7 @@ DWARFDebugInfoEntry::Extract
         }
         else
         {
-            m_abbrevDecl = NULL;
+            SetAbbreviationDeclaration (0, NULL);
             *offset_ptr = offset;
             return true;    // NULL debug tag entry
         }
@@ -388,7 +461,8 @@ DWARFDebugInfoEntry::AppendDependentDIES
 
     //DEBUG_PRINTF("    dependent_dies.Insert(0x%8.8x)\n", GetOffset());///
 
-    if (m_abbrevDecl)
+    const DWARFAbbreviationDeclaration* abbrevDecl = GetAbbreviationDeclarationPtr (cu);
+    if (abbrevDecl)
     {
         // Keep adding parent DIE offsets as long as the offsets do not
         // already exist in the collection
@@ -401,7 +475,7 @@ DWARFDebugInfoEntry::AppendDependentDIES
 
         if (!add_children)
         {
-            switch (m_abbrevDecl->Tag())
+            switch (m_tag)
             {
             case DW_TAG_array_type:                                             break;
             case DW_TAG_class_type:         add_non_subprogram_children = true; break;
@@ -464,7 +538,7 @@ DWARFDebugInfoEntry::AppendDependentDIES
         const DataExtractor& debug_info_data = dwarf2Data->get_debug_info_data();
 
         // Dump all data in the .debug_info for the attributes
-        const uint32_t numAttributes = m_abbrevDecl->NumAttributes();
+        const uint32_t numAttributes = abbrevDecl->NumAttributes();
         uint32_t i;
         dw_offset_t offset = GetOffset();
         debug_info_data.Skip_LEB128(&offset);   // Skip abbreviation code
@@ -473,7 +547,7 @@ DWARFDebugInfoEntry::AppendDependentDIES
         dw_form_t form;
         for (i=0; i<numAttributes; ++i)
         {
-            m_abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
+            abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
             DWARFFormValue form_value(form);
 
             switch (attr)
@@ -513,7 +587,7 @@ DWARFDebugInfoEntry::AppendDependentDIES
                     case DW_FORM_ref8:
                     case DW_FORM_ref_udata:
 //                      Log::WarningVerbose("DWARFDebugInfoEntry::AppendDependentDIES() -- check on this item %s: attr = %s  form = %s",
-//                          DW_TAG_value_to_name(m_abbrevDecl->Tag()),
+//                          DW_TAG_value_to_name(m_tag),
 //                          DW_AT_value_to_name(attr),
 //                          DW_FORM_value_to_name(form));
                         break;
@@ -524,7 +598,7 @@ DWARFDebugInfoEntry::AppendDependentDIES
             }
         }
 
-        if (m_abbrevDecl->HasChildren())
+        if (m_has_children)
         {
             const DWARFDebugInfoEntry* child;
             for (child = GetFirstChild(); child != NULL; child = child->GetSibling())
@@ -894,7 +968,8 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
     dw_addr_t hi_pc = DW_INVALID_ADDRESS;
     std::vector<dw_offset_t> die_offsets;
     bool set_frame_base_loclist_addr = false;
-    if (m_abbrevDecl)
+    const DWARFAbbreviationDeclaration* abbrevDecl = GetAbbreviationDeclarationPtr (cu);
+    if (abbrevDecl)
     {
         const DataExtractor& debug_info_data = dwarf2Data->get_debug_info_data();
         uint32_t offset = m_offset;
@@ -905,13 +980,13 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
         // Skip the abbreviation code
         debug_info_data.Skip_LEB128(&offset);
 
-        const uint32_t numAttributes = m_abbrevDecl->NumAttributes();
+        const uint32_t numAttributes = abbrevDecl->NumAttributes();
         uint32_t i;
         dw_attr_t attr;
         dw_form_t form;
         for (i=0; i<numAttributes; ++i)
         {
-            m_abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
+            abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
             DWARFFormValue form_value(form);
             if (form_value.ExtractValue(debug_info_data, &offset, cu))
             {
@@ -1089,19 +1164,20 @@ DWARFDebugInfoEntry::Dump
         s->Indent();
         if (abbrCode)
         {
-            if (m_abbrevDecl)
+            const DWARFAbbreviationDeclaration* abbrevDecl = GetAbbreviationDeclarationPtr (cu);
+            if (abbrevDecl)
             {
-                s->PutCString(DW_TAG_value_to_name(m_abbrevDecl->Tag()));
-                s->Printf( " [%u] %c\n", abbrCode, m_abbrevDecl->HasChildren() ? '*':' ');
+                s->PutCString(DW_TAG_value_to_name(abbrevDecl->Tag()));
+                s->Printf( " [%u] %c\n", abbrCode, abbrevDecl->HasChildren() ? '*':' ');
 
                 // Dump all data in the .debug_info for the attributes
-                const uint32_t numAttributes = m_abbrevDecl->NumAttributes();
+                const uint32_t numAttributes = abbrevDecl->NumAttributes();
                 uint32_t i;
                 dw_attr_t attr;
                 dw_form_t form;
                 for (i=0; i<numAttributes; ++i)
                 {
-                    m_abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
+                    abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
 
                     DumpAttribute(dwarf2Data, cu, debug_info_data, &offset, s, attr, form);
                 }
@@ -1302,7 +1378,8 @@ DWARFDebugInfoEntry::GetAttributes
     uint32_t curr_depth
 ) const
 {
-    if (m_abbrevDecl)
+    const DWARFAbbreviationDeclaration* abbrevDecl = GetAbbreviationDeclarationPtr (cu);
+    if (abbrevDecl)
     {
         if (fixed_form_sizes == NULL)
             fixed_form_sizes = DWARFFormValue::GetFixedFormSizesForAddressSize(cu->GetAddressByteSize());
@@ -1312,14 +1389,14 @@ DWARFDebugInfoEntry::GetAttributes
         // Skip the abbreviation code so we are at the data for the attributes
         debug_info_data.Skip_LEB128(&offset);
 
-        const uint32_t num_attributes = m_abbrevDecl->NumAttributes();
+        const uint32_t num_attributes = abbrevDecl->NumAttributes();
         uint32_t i;
         dw_attr_t attr;
         dw_form_t form;
         DWARFFormValue form_value;
         for (i=0; i<num_attributes; ++i)
         {
-            m_abbrevDecl->GetAttrAndFormByIndexUnchecked (i, attr, form);
+            abbrevDecl->GetAttrAndFormByIndexUnchecked (i, attr, form);
             
             // If we are tracking down DW_AT_specification or DW_AT_abstract_origin
             // attributes, the depth will be non-zero. We need to omit certain
@@ -1399,9 +1476,10 @@ DWARFDebugInfoEntry::GetAttributeValue
     dw_offset_t* end_attr_offset_ptr
 ) const
 {
-    if (m_abbrevDecl)
+    const DWARFAbbreviationDeclaration* abbrevDecl = GetAbbreviationDeclarationPtr (cu);
+    if (abbrevDecl)
     {
-        uint32_t attr_idx = m_abbrevDecl->FindAttributeIndex(attr);
+        uint32_t attr_idx = abbrevDecl->FindAttributeIndex(attr);
 
         if (attr_idx != DW_INVALID_INDEX)
         {
@@ -1414,10 +1492,10 @@ DWARFDebugInfoEntry::GetAttributeValue
 
             uint32_t idx=0;
             while (idx<attr_idx)
-                DWARFFormValue::SkipValue(m_abbrevDecl->GetFormByIndex(idx++), debug_info_data, &offset, cu);
+                DWARFFormValue::SkipValue(abbrevDecl->GetFormByIndex(idx++), debug_info_data, &offset, cu);
 
             const dw_offset_t attr_offset = offset;
-            form_value.SetForm(m_abbrevDecl->GetFormByIndex(idx));
+            form_value.SetForm(abbrevDecl->GetFormByIndex(idx));
             if (form_value.ExtractValue(debug_info_data, &offset, cu))
             {
                 if (end_attr_offset_ptr)
@@ -1725,9 +1803,9 @@ DWARFDebugInfoEntry::AppendTypeName
             else
             {
                 bool result = true;
-                const DWARFAbbreviationDeclaration* abbrevDecl = die.GetAbbreviationDeclarationPtr();
+                const dw_tag_t tag = die.Tag();
 
-                switch (abbrevDecl->Tag())
+                switch (tag)
                 {
                 case DW_TAG_array_type:         break;  // print out a "[]" after printing the full type of the element below
                 case DW_TAG_base_type:          s->PutCString("base ");         break;
@@ -1763,7 +1841,7 @@ DWARFDebugInfoEntry::AppendTypeName
                     result = AppendTypeName(dwarf2Data, cu, next_die_offset, s);
                 }
 
-                switch (abbrevDecl->Tag())
+                switch (tag)
                 {
                 case DW_TAG_array_type:         s->PutCString("[]");    break;
                 case DW_TAG_pointer_type:       s->PutChar('*');    break;
@@ -1790,9 +1868,9 @@ DWARFDebugInfoEntry::BuildAddressRangeTable
     DWARFDebugAranges* debug_aranges
 ) const
 {
-    if (m_abbrevDecl)
+    if (!IsNULL())
     {
-        dw_tag_t tag = m_abbrevDecl->Tag();
+        dw_tag_t tag = m_tag;
         if (tag == DW_TAG_subprogram)
         {
             dw_addr_t hi_pc = DW_INVALID_ADDRESS;
@@ -1832,9 +1910,9 @@ DWARFDebugInfoEntry::BuildFunctionAddressRangeTable
     DWARFDebugAranges* debug_aranges
 ) const
 {
-    if (m_abbrevDecl)
+    if (!IsNULL())
     {
-        dw_tag_t tag = m_abbrevDecl->Tag();
+        dw_tag_t tag = m_tag;
         if (tag == DW_TAG_subprogram)
         {
             dw_addr_t hi_pc = DW_INVALID_ADDRESS;
@@ -1872,11 +1950,11 @@ DWARFDebugInfoEntry::LookupAddress
 )
 {
     bool found_address = false;
-    if (m_abbrevDecl)
+    if (!IsNULL())
     {
         bool check_children = false;
         bool match_addr_range = false;
-        dw_tag_t tag = m_abbrevDecl->Tag();
+        dw_tag_t tag = m_tag;
     //  printf("0x%8.8x: %30s: address = 0x%8.8x - ", m_offset, DW_TAG_value_to_name(tag), address);
         switch (tag)
         {
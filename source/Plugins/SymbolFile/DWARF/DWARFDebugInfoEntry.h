@@ -41,6 +41,12 @@ typedef std::multimap<uint32_t, const DWARFDebugInfoEntry*> UInt32ToDIEMMap;
 typedef UInt32ToDIEMMap::iterator                           UInt32ToDIEMMapIter;
 typedef UInt32ToDIEMMap::const_iterator                     UInt32ToDIEMMapConstIter;
 
+#define DIE_ABBR_IDX_BITSIZE 15
+#define DIE_ABBR_IDX_MAX ((1u << DIE_ABBR_IDX_BITSIZE) - 1)
+// Abbreviation codes that don't fit are stored as DIE_ABBR_IDX_LARGE and
+// the real code is decoded again from the .debug_info when it is needed.
+#define DIE_ABBR_IDX_LARGE DIE_ABBR_IDX_MAX
+
 class DWARFDebugInfoEntry
 {
 public:
@@ -105,7 +111,9 @@ public:
                     m_offset        (DW_INVALID_OFFSET),
                     m_parent_idx    (0),
                     m_sibling_idx   (0),
-                    m_abbrevDecl    (NULL)
+                    m_abbr_idx      (0),
+                    m_has_children  (0),
+                    m_tag           (0)
                 {
                 }
 
@@ -271,12 +279,12 @@ public:
                     lldb_private::DWARFExpression *frame_base = NULL) const;
 
 
-    dw_tag_t    Tag()           const { return m_abbrevDecl ? m_abbrevDecl->Tag() : 0; }
-    bool        IsNULL()        const { return m_abbrevDecl == NULL; }
+    dw_tag_t    Tag()           const { return m_tag; }
+    bool        IsNULL()        const { return m_abbr_idx == 0; }
     dw_offset_t GetOffset()     const { return m_offset; }
     void        SetOffset(dw_offset_t offset) { m_offset = offset; }
-    uint32_t    NumAttributes() const { return m_abbrevDecl ? m_abbrevDecl->NumAttributes() : 0; }
-    bool        HasChildren()   const { return m_abbrevDecl != NULL && m_abbrevDecl->HasChildren(); }
+    uint32_t    NumAttributes(const DWARFCompileUnit* cu) const;
+    bool        HasChildren()   const { return m_has_children; }
 
             // We know we are kept in a vector of contiguous entries, so we know
             // our parent will be some index behind "this".
@@ -317,13 +325,25 @@ public:
         else        
             m_sibling_idx = 0;
     }
-    const DWARFAbbreviationDeclaration* GetAbbreviationDeclarationPtr() const { return m_abbrevDecl; }
+    const DWARFAbbreviationDeclaration* GetAbbreviationDeclarationPtr(const DWARFCompileUnit* cu) const;
 
 protected:
-    dw_offset_t                         m_offset;       // Offset within the .debug_info of the start of this entry
-    uint32_t                            m_parent_idx;   // How many to subtract from "this" to get the parent. If zero this die has no parent
-    uint32_t                            m_sibling_idx;  // How many to add to "this" to get the sibling.
-    const DWARFAbbreviationDeclaration* m_abbrevDecl;
+    bool        SetAbbreviationDeclaration(
+                    dw_uleb128_t abbr_code,
+                    const DWARFAbbreviationDeclaration* abbrevDecl);
+
+    // DIEs are stored by the million, so keep them packed into 16 bytes.
+    // Instead of a DWARFAbbreviationDeclaration pointer we store the
+    // abbreviation code, which indexes into the abbreviation set of the
+    // compile unit that owns this DIE, along with a copy of the tag and
+    // children flag. Codes that don't fit in m_abbr_idx are stored as
+    // DIE_ABBR_IDX_LARGE and read back from the .debug_info at m_offset.
+    dw_offset_t m_offset;                           // Offset within the .debug_info of the start of this entry
+    uint32_t    m_parent_idx;                       // How many to subtract from "this" to get the parent. If zero this die has no parent
+    uint32_t    m_sibling_idx;                      // How many to add to "this" to get the sibling.
+    uint32_t    m_abbr_idx:DIE_ABBR_IDX_BITSIZE,    // The abbreviation code for this DIE within its compile unit's abbreviation set, zero for NULL entries
+                m_has_children:1,                   // Set to 1 if this DIE has children
+                m_tag:16;                           // A copy of the DW_TAG value so we don't have to go through the compile unit abbrev table
 };
 
 #endif  // liblldb_DWARFDebugInfoEntry_h_
@@ -578,6 +578,33 @@ DWARFDebugLine::ParseStatementTable
 
     assert(debug_line_data.ValidOffset(end_offset-1));
 
+    ParseStatementProgram (debug_line_data, prologue, offset_ptr, end_offset, callback, userData);
+    return end_offset;
+}
+
+//----------------------------------------------------------------------
+// ParseStatementProgram
+//
+// Run the line table state machine over the statement program opcodes
+// starting at "*offset_ptr" and ending at "end_offset", calling the
+// callback for each row. The state machine registers are reset after
+// each DW_LNE_end_sequence, so the start offset of any sequence can be
+// used as the start of a program to only parse the rows of that
+// sequence.
+//----------------------------------------------------------------------
+bool
+DWARFDebugLine::ParseStatementProgram
+(
+    const DataExtractor& debug_line_data,
+    Prologue::shared_ptr& prologue,
+    dw_offset_t* offset_ptr,
+    dw_offset_t end_offset,
+    DWARFDebugLine::State::Callback callback,
+    void* userData
+)
+{
+    Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_LINE);
+
     State state(prologue, log, callback, userData);
 
     while (*offset_ptr < end_offset)
@@ -814,7 +841,7 @@ DWARFDebugLine::ParseStatementTable
 
     state.Finalize( *offset_ptr );
 
-    return end_offset;
+    return true;
 }
 
 
@@ -8,6 +8,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "NameToDIE.h"
+
+#include <algorithm>
+
 #include "lldb/Core/Stream.h"
 
 size_t
@@ -23,10 +26,56 @@ NameToDIE::Find (const lldb_private::ConstString &name, std::vector<Info> &info_
     return info_array.size() - initial_info_array_size;
 }
 
+struct NameToDIEEntryLessThan
+{
+    typedef std::multimap<const char *, NameToDIE::Info>::const_iterator iterator;
+
+    bool
+    operator() (const iterator &lhs, const iterator &rhs) const
+    {
+        return ::strcmp (lhs->first, rhs->first) < 0;
+    }
+
+    bool
+    operator() (const iterator &lhs, const char *rhs) const
+    {
+        return ::strcmp (lhs->first, rhs) < 0;
+    }
+};
+
+void
+NameToDIE::Finalize ()
+{
+    m_sorted_names.clear();
+    m_sorted_names.reserve (m_collection.size());
+    collection::const_iterator pos, end = m_collection.end();
+    for (pos = m_collection.begin(); pos != end; ++pos)
+        m_sorted_names.push_back (pos);
+    std::stable_sort (m_sorted_names.begin(), m_sorted_names.end(), NameToDIEEntryLessThan());
+}
+
 size_t
 NameToDIE::Find (const lldb_private::RegularExpression& regex, std::vector<Info> &info_array) const
 {
     const size_t initial_info_array_size = info_array.size();
+
+    // Only names that start with the regular expression's literal prefix
+    // can match, and they are all next to each other when sorted by name
+    const char *prefix = regex.GetRequiredPrefix();
+    if (prefix && !m_collection.empty() && m_sorted_names.size() == m_collection.size())
+    {
+        const size_t prefix_len = ::strlen (prefix);
+        sorted_names::const_iterator pos, begin = m_sorted_names.begin(), end = m_sorted_names.end();
+        for (pos = std::lower_bound (begin, end, prefix, NameToDIEEntryLessThan());
+             pos != end && ::strncmp ((*pos)->first, prefix, prefix_len) == 0;
+             ++pos)
+        {
+            if (regex.Execute((*pos)->first))
+                info_array.push_back ((*pos)->second);
+        }
+        return info_array.size() - initial_info_array_size;
+    }
+
     collection::const_iterator pos, end = m_collection.end();
     for (pos = m_collection.begin(); pos != end; ++pos)
     {
@@ -11,6 +11,7 @@
 #define SymbolFileDWARF_NameToDIE_h_
 
 #include <map>
+#include <vector>
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/RegularExpression.h"
 
@@ -25,7 +26,8 @@ public:
     
 
     NameToDIE () :
-        m_collection ()
+        m_collection (),
+        m_sorted_names ()
     {
     }
     
@@ -40,7 +42,17 @@ public:
     Insert (const lldb_private::ConstString& name, const Info &info)
     {
         m_collection.insert (std::make_pair(name.AsCString(), info));
+        m_sorted_names.clear();
     }
+
+    //------------------------------------------------------------------
+    /// Sort the names for prefix searches. Call this once all of the
+    /// names have been inserted and before any searches are done, the
+    /// const Find() functions don't modify the index so they can be
+    /// called from multiple threads.
+    //------------------------------------------------------------------
+    void
+    Finalize ();
     
     size_t
     Find (const lldb_private::ConstString &name, 
@@ -56,8 +68,13 @@ public:
 
 protected:
     typedef std::multimap<const char *, Info> collection;
+    typedef std::vector<collection::const_iterator> sorted_names;
 
     collection m_collection;
+    // "m_collection" is sorted by ConstString pointer, this is the same
+    // entries sorted by name so names with a common prefix are contiguous.
+    // Built by Finalize() and cleared by Insert().
+    sorted_names m_sorted_names;
 };
 
 #endif  // SymbolFileDWARF_NameToDIE_h_
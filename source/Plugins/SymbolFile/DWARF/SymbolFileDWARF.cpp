@@ -22,6 +22,7 @@
 #include "clang/Basic/Specifiers.h"
 #include "clang/Sema/DeclSpec.h"
 
+#include "lldb/Core/DataBufferMemoryMap.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/RegularExpression.h"
@@ -53,6 +54,7 @@
 #include "LogChannelDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
 
+#include <algorithm>
 #include <map>
 
 //#define ENABLE_DEBUG_PRINTF // COMMENT OUT THIS LINE PRIOR TO CHECKIN
@@ -177,7 +179,9 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_global_index(),
     m_type_index(),
     m_namespace_index(),
+    m_support_file_index(),
     m_indexed (false),
+    m_indexed_support_files (false),
     m_is_external_ast_source (false),
     m_ranges(),
     m_unique_ast_type_map ()
@@ -386,8 +390,31 @@ SymbolFileDWARF::GetCachedSectionData (uint32_t got_flag, SectionType sect_type,
                 }
                 else
                 {
-                    if (section->ReadSectionDataFromObjectFile(m_obj_file, data) == 0)
-                        data.Clear();
+                    // No DWARF segment (ELF and other formats that keep each
+                    // debug section on its own), so memory map each section
+                    // individually to avoid copying the debug info onto the
+                    // heap. Sections that get walked from start to end during
+                    // indexing get read ahead, the rest are random lookups.
+                    DataBufferMemoryMap::AccessPattern access_pattern;
+                    switch (sect_type)
+                    {
+                    case eSectionTypeDWARFDebugAbbrev:
+                    case eSectionTypeDWARFDebugInfo:
+                    case eSectionTypeDWARFDebugLine:
+                        access_pattern = DataBufferMemoryMap::eAccessPatternSequential;
+                        break;
+                    default:
+                        access_pattern = DataBufferMemoryMap::eAccessPatternRandom;
+                        break;
+                    }
+
+                    if (section->MemoryMapSectionDataFromObjectFile(m_obj_file, data, access_pattern) == 0)
+                    {
+                        // Fall back to reading the section into the heap if
+                        // the memory map fails.
+                        if (section->ReadSectionDataFromObjectFile(m_obj_file, data) == 0)
+                            data.Clear();
+                    }
                 }
             }
         }
@@ -959,6 +986,109 @@ ParseDWARFLineTableCallback(dw_offset_t offset, const DWARFDebugLine::State& sta
     }
 }
 
+//----------------------------------------------------------------------
+// DWARFLineTableSequenceParser
+//
+// Parses the rows of individual line table sequences on demand. Each
+// DW_LNE_end_sequence resets the line table state machine, so the rows
+// of a sequence can be built by running the state machine over just
+// the opcodes for that sequence.
+//----------------------------------------------------------------------
+class DWARFLineTableSequenceParser : public LineTable::SequenceParser
+{
+public:
+    DWARFLineTableSequenceParser (SymbolFileDWARF *dwarf2Data, 
+                                  DWARFDebugLine::Prologue::shared_ptr &prologue_sp) :
+        m_dwarf2Data (dwarf2Data),
+        m_prologue_sp (prologue_sp),
+        m_sequences ()
+    {
+    }
+
+    virtual
+    ~DWARFLineTableSequenceParser ()
+    {
+    }
+
+    // Returns the sequence ID for the sequence of opcodes in
+    // [start_offset, end_offset) in the .debug_line section
+    uint32_t
+    AddSequence (dw_offset_t start_offset, dw_offset_t end_offset)
+    {
+        m_sequences.push_back (std::make_pair (start_offset, end_offset));
+        return m_sequences.size() - 1;
+    }
+
+    virtual void
+    ParseSequence (LineTable &line_table, uint32_t sequence_id)
+    {
+        if (sequence_id < m_sequences.size())
+        {
+            ParseDWARFLineTableCallbackInfo info = { &line_table, m_dwarf2Data->GetObjectFile()->GetSectionList(), 0, 0, false, false };
+            dw_offset_t offset = m_sequences[sequence_id].first;
+            DWARFDebugLine::ParseStatementProgram (m_dwarf2Data->get_debug_line_data(), 
+                                                   m_prologue_sp, 
+                                                   &offset, 
+                                                   m_sequences[sequence_id].second, 
+                                                   ParseDWARFLineTableCallback, 
+                                                   &info);
+        }
+    }
+
+protected:
+    SymbolFileDWARF *m_dwarf2Data;
+    DWARFDebugLine::Prologue::shared_ptr m_prologue_sp;
+    std::vector<std::pair<dw_offset_t, dw_offset_t> > m_sequences;
+};
+
+struct IndexDWARFLineTableSequencesCallbackInfo
+{
+    LineTable* line_table;
+    DWARFLineTableSequenceParser* sequence_parser;
+    dw_offset_t sequence_offset;    // The .debug_line offset of the first opcode in the current sequence
+    dw_addr_t sequence_lo_addr;
+    dw_addr_t sequence_hi_addr;
+    bool sequence_has_rows;
+};
+
+//----------------------------------------------------------------------
+// IndexDWARFLineTableSequencesCallback
+//
+// Records the address range and opcode range of each sequence in a
+// line table program without building any line table rows.
+//----------------------------------------------------------------------
+static void
+IndexDWARFLineTableSequencesCallback (dw_offset_t offset, const DWARFDebugLine::State& state, void* userData)
+{
+    if (state.row == DWARFDebugLine::State::StartParsingLineTable ||
+        state.row == DWARFDebugLine::State::DoneParsingLineTable)
+        return;
+
+    IndexDWARFLineTableSequencesCallbackInfo* info = (IndexDWARFLineTableSequencesCallbackInfo*)userData;
+    if (info->sequence_has_rows)
+    {
+        if (info->sequence_lo_addr > state.address)
+            info->sequence_lo_addr = state.address;
+        if (info->sequence_hi_addr < state.address)
+            info->sequence_hi_addr = state.address;
+    }
+    else
+    {
+        info->sequence_lo_addr = info->sequence_hi_addr = state.address;
+        info->sequence_has_rows = true;
+    }
+
+    if (state.end_sequence)
+    {
+        // "offset" is the offset of the opcode that follows the
+        // DW_LNE_end_sequence which is where the next sequence starts
+        const uint32_t sequence_id = info->sequence_parser->AddSequence (info->sequence_offset, offset);
+        info->line_table->AppendSequence (info->sequence_lo_addr, info->sequence_hi_addr, sequence_id);
+        info->sequence_offset = offset;
+        info->sequence_has_rows = false;
+    }
+}
+
 bool
 SymbolFileDWARF::ParseCompileUnitLineTable (const SymbolContext &sc)
 {
@@ -976,9 +1106,32 @@ SymbolFileDWARF::ParseCompileUnitLineTable (const SymbolContext &sc)
             std::auto_ptr<LineTable> line_table_ap(new LineTable(sc.comp_unit));
             if (line_table_ap.get())
             {
-                ParseDWARFLineTableCallbackInfo info = { line_table_ap.get(), m_obj_file->GetSectionList(), 0, 0, m_debug_map_symfile != NULL, false};
-                uint32_t offset = cu_line_offset;
-                DWARFDebugLine::ParseStatementTable(get_debug_line_data(), &offset, ParseDWARFLineTableCallback, &info);
+                if (m_debug_map_symfile == NULL)
+                {
+                    // Only find the address range of each sequence now and
+                    // build the rows for a sequence when it is looked up.
+                    // Large compile units often only ever get a few address
+                    // lookups.
+                    const DataExtractor& debug_line_data = get_debug_line_data();
+                    DWARFDebugLine::Prologue::shared_ptr prologue_sp (new DWARFDebugLine::Prologue());
+                    uint32_t offset = cu_line_offset;
+                    if (DWARFDebugLine::ParsePrologue (debug_line_data, &offset, prologue_sp.get()))
+                    {
+                        const dw_offset_t end_offset = cu_line_offset + prologue_sp->total_length + sizeof(prologue_sp->total_length);
+                        DWARFLineTableSequenceParser *sequence_parser = new DWARFLineTableSequenceParser (this, prologue_sp);
+                        line_table_ap->SetSequenceParser (sequence_parser);
+                        IndexDWARFLineTableSequencesCallbackInfo info = { line_table_ap.get(), sequence_parser, offset, 0, 0, false };
+                        DWARFDebugLine::ParseStatementProgram (debug_line_data, prologue_sp, &offset, end_offset, IndexDWARFLineTableSequencesCallback, &info);
+                    }
+                }
+                else
+                {
+                    // Debug map line tables need to be remapped row by row
+                    // as they are inserted, so parse everything now.
+                    ParseDWARFLineTableCallbackInfo info = { line_table_ap.get(), m_obj_file->GetSectionList(), 0, 0, m_debug_map_symfile != NULL, false};
+                    uint32_t offset = cu_line_offset;
+                    DWARFDebugLine::ParseStatementTable(get_debug_line_data(), &offset, ParseDWARFLineTableCallback, &info);
+                }
                 sc.comp_unit->SetLineTable(line_table_ap.release());
                 return true;
             }
@@ -1746,11 +1899,19 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
         DWARFDebugInfo* debug_info = DebugInfo();
         if (debug_info)
         {
-            uint32_t cu_idx;
-            DWARFCompileUnit* curr_cu = NULL;
+            // Only look at the compile units that reference a file with
+            // the same basename as "file_spec"
+            std::vector<uint32_t> cu_indexes;
+            GetCompileUnitIndexesForFile (file_spec, cu_indexes);
 
-            for (cu_idx = 0; (curr_cu = debug_info->GetCompileUnitAtIndex(cu_idx)) != NULL; ++cu_idx)
+            std::vector<uint32_t>::const_iterator pos, end = cu_indexes.end();
+            for (pos = cu_indexes.begin(); pos != end; ++pos)
             {
+                const uint32_t cu_idx = *pos;
+                DWARFCompileUnit* curr_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+                if (curr_cu == NULL)
+                    continue;
+
                 CompileUnit *dc_cu = GetCompUnitForDWARFCompUnit(curr_cu, cu_idx);
                 bool file_spec_matches_cu_file_spec = dc_cu != NULL && FileSpec::Compare(file_spec, *dc_cu, false) == 0;
                 if (check_inlines || file_spec_matches_cu_file_spec)
@@ -1847,6 +2008,89 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
     return sc_list.GetSize() - prev_size;
 }
 
+//----------------------------------------------------------------------
+// Make an index of the basenames of the source files that each compile
+// unit references to the index of the compile unit. Only the compile
+// unit DIEs and the line table prologues are parsed, so file and line
+// lookups don't need to parse the support files and line tables for
+// every compile unit.
+//----------------------------------------------------------------------
+void
+SymbolFileDWARF::IndexSupportFiles ()
+{
+    if (m_indexed_support_files)
+        return;
+    m_indexed_support_files = true;
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "SymbolFileDWARF::IndexSupportFiles (%s)",
+                        GetObjectFile()->GetFileSpec().GetFilename().AsCString());
+
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info == NULL)
+        return;
+
+    const DataExtractor& debug_line_data = get_debug_line_data();
+    const uint32_t num_compile_units = GetNumCompileUnits();
+    for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+    {
+        DWARFCompileUnit* curr_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+        const DWARFDebugInfoEntry * cu_die = curr_cu ? curr_cu->GetCompileUnitDIEOnly() : NULL;
+        if (cu_die == NULL)
+            continue;
+
+        FileSpec cu_file_spec (cu_die->GetName(this, curr_cu), false);
+        if (cu_file_spec.GetFilename())
+            m_support_file_index.Append (cu_file_spec.GetFilename().GetCString(), cu_idx);
+
+        dw_offset_t stmt_list = cu_die->GetAttributeValueAsUnsigned(this, curr_cu, DW_AT_stmt_list, DW_INVALID_OFFSET);
+        if (stmt_list == DW_INVALID_OFFSET)
+            continue;
+
+        DWARFDebugLine::Prologue prologue;
+        dw_offset_t offset = stmt_list;
+        if (!DWARFDebugLine::ParsePrologue (debug_line_data, &offset, &prologue))
+            continue;
+
+        std::vector<DWARFDebugLine::FileNameEntry>::const_iterator pos, end = prologue.file_names.end();
+        for (pos = prologue.file_names.begin(); pos != end; ++pos)
+        {
+            const char *path = pos->name.c_str();
+            const char *basename = ::strrchr (path, '/');
+            basename = basename ? basename + 1 : path;
+            if (basename[0])
+                m_support_file_index.Append (ConstString(basename).GetCString(), cu_idx);
+        }
+    }
+    m_support_file_index.Sort();
+}
+
+void
+SymbolFileDWARF::GetCompileUnitIndexesForFile (const FileSpec& file_spec, std::vector<uint32_t> &cu_indexes)
+{
+    const ConstString &basename = file_spec.GetFilename();
+    if (!basename)
+    {
+        // Without a basename every compile unit might match
+        const uint32_t num_compile_units = GetNumCompileUnits();
+        for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+            cu_indexes.push_back (cu_idx);
+        return;
+    }
+
+    IndexSupportFiles ();
+
+    const UniqueCStringMap<uint32_t>::Entry *entry = m_support_file_index.FindFirstValueForName (basename.GetCString());
+    while (entry != NULL)
+    {
+        cu_indexes.push_back (entry->value);
+        entry = m_support_file_index.FindNextValueForName (basename.GetCString(), entry);
+    }
+
+    // Keep the compile units in the same order they appear in the DWARF
+    std::sort (cu_indexes.begin(), cu_indexes.end());
+    cu_indexes.erase (std::unique (cu_indexes.begin(), cu_indexes.end()), cu_indexes.end());
+}
+
 void
 SymbolFileDWARF::Index ()
 {
@@ -1890,6 +2134,15 @@ SymbolFileDWARF::Index ()
         
         m_aranges->Sort();
 
+        m_function_basename_index.Finalize();
+        m_function_fullname_index.Finalize();
+        m_function_method_index.Finalize();
+        m_function_selector_index.Finalize();
+        m_objc_class_selectors_index.Finalize();
+        m_global_index.Finalize();
+        m_type_index.Finalize();
+        m_namespace_index.Finalize();
+
 #if defined (ENABLE_DEBUG_PRINTF)
         StreamFile s(stdout, false);
         s.Printf ("DWARF index for (%s) '%s/%s':", 
@@ -313,6 +313,11 @@ protected:
 
     void                    Index();
 
+    void                    IndexSupportFiles();
+
+    void                    GetCompileUnitIndexesForFile (const lldb_private::FileSpec& file_spec,
+                                                          std::vector<uint32_t> &cu_indexes);
+
     void                    SetDebugMapSymfile (SymbolFileDWARFDebugMap *debug_map_symfile)
                             {
                                 m_debug_map_symfile = debug_map_symfile;
@@ -350,7 +355,9 @@ protected:
     NameToDIE                           m_global_index;                 // Global and static variables
     NameToDIE                           m_type_index;                  // All type DIE offsets
     NameToDIE                           m_namespace_index;              // All type DIE offsets
+    lldb_private::UniqueCStringMap<uint32_t> m_support_file_index;      // Support file basename to compile unit index
     bool m_indexed:1,
+         m_indexed_support_files:1,
          m_is_external_ast_source:1;
 
     std::auto_ptr<DWARFDebugRanges>     m_ranges;
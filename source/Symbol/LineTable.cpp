@@ -23,7 +23,10 @@ using namespace lldb_private;
 LineTable::LineTable(CompileUnit* comp_unit) :
     m_comp_unit(comp_unit),
     m_section_list(),
-    m_entries()
+    m_entries(),
+    m_sequences(),
+    m_num_unparsed_sequences(0),
+    m_sequence_parser_ap()
 {
 }
 
@@ -102,6 +105,119 @@ LineTable::InsertLineEntry
 //  Dump (&s, Address::DumpStyleFileAddress);
 }
 
+void
+LineTable::SetSequenceParser (SequenceParser *parser)
+{
+    m_sequence_parser_ap.reset (parser);
+}
+
+void
+LineTable::AppendSequence (addr_t file_addr, addr_t end_file_addr, uint32_t sequence_id)
+{
+    Sequence sequence = { file_addr, end_file_addr, sequence_id, false };
+    m_sequences.push_back (sequence);
+    ++m_num_unparsed_sequences;
+}
+
+//----------------------------------------------------------------------
+// Parse the rows for any sequences whose address range contains
+// "file_addr" and move each one in front of the first sequence that
+// starts after it.
+//----------------------------------------------------------------------
+void
+LineTable::ParseSequencesContainingFileAddress (addr_t file_addr)
+{
+    if (m_num_unparsed_sequences == 0 || m_sequence_parser_ap.get() == NULL)
+        return;
+
+    const size_t num_sequences = m_sequences.size();
+    for (size_t i=0; i<num_sequences; ++i)
+    {
+        Sequence &sequence = m_sequences[i];
+        if (sequence.parsed || file_addr < sequence.file_addr || file_addr >= sequence.end_file_addr)
+            continue;
+
+        sequence.parsed = true;
+        --m_num_unparsed_sequences;
+
+        const size_t first_new_idx = m_entries.size();
+        m_sequence_parser_ap->ParseSequence (*this, sequence.sequence_id);
+        if (first_new_idx == 0 || first_new_idx == m_entries.size())
+            continue;
+
+        entry_collection::iterator begin_pos = m_entries.begin();
+        entry_collection::iterator new_pos = begin_pos + first_new_idx;
+        entry_collection::iterator pos = std::upper_bound (begin_pos, new_pos, *new_pos, Entry::SequenceStartsBefore);
+        // Never split an existing sequence, even if it overlaps this one
+        while (pos != begin_pos && pos != new_pos && (pos - 1)->is_terminal_entry == false)
+            ++pos;
+        std::rotate (pos, new_pos, m_entries.end());
+    }
+}
+
+//----------------------------------------------------------------------
+// Parse the rows for all sequences that haven't been parsed yet. This
+// is needed before anything that uses entry indexes or walks all rows
+// so entry indexes don't change after they have been handed out.
+//----------------------------------------------------------------------
+void
+LineTable::ParseAllSequences ()
+{
+    if (m_num_unparsed_sequences == 0 || m_sequence_parser_ap.get() == NULL)
+        return;
+
+    const size_t num_sequences = m_sequences.size();
+    for (size_t i=0; i<num_sequences; ++i)
+    {
+        Sequence &sequence = m_sequences[i];
+        if (!sequence.parsed)
+        {
+            sequence.parsed = true;
+            m_sequence_parser_ap->ParseSequence (*this, sequence.sequence_id);
+        }
+    }
+    m_num_unparsed_sequences = 0;
+
+    // Sequences aren't guaranteed to be in address order, so split the
+    // rows back into sequences at the terminal entries and sort the
+    // sequences as a whole by the address of their first row (in the
+    // order Entry::EntryAddressLessThan() uses).
+    typedef std::pair<uint64_t, size_t> SequenceStart;
+    std::vector<SequenceStart> sequence_starts;
+    std::vector<size_t> sequence_ends;
+    const size_t num_entries = m_entries.size();
+    size_t begin_idx = 0;
+    for (size_t idx = 0; idx < num_entries; ++idx)
+    {
+        if (m_entries[idx].is_terminal_entry || idx + 1 == num_entries)
+        {
+            const Entry &first = m_entries[begin_idx];
+            sequence_starts.push_back (SequenceStart(((uint64_t)first.sect_idx << 32) | first.sect_offset, sequence_ends.size()));
+            sequence_ends.push_back (idx + 1);
+            begin_idx = idx + 1;
+        }
+    }
+    // Ties are broken by the original position, so this is stable
+    std::sort (sequence_starts.begin(), sequence_starts.end());
+
+    entry_collection sorted_entries;
+    sorted_entries.reserve (num_entries);
+    std::vector<SequenceStart>::const_iterator pos, end = sequence_starts.end();
+    for (pos = sequence_starts.begin(); pos != end; ++pos)
+    {
+        const size_t sequence_idx = pos->second;
+        const size_t sequence_begin_idx = sequence_idx > 0 ? sequence_ends[sequence_idx - 1] : 0;
+        sorted_entries.insert (sorted_entries.end(), 
+                               m_entries.begin() + sequence_begin_idx, 
+                               m_entries.begin() + sequence_ends[sequence_idx]);
+    }
+    m_entries.swap (sorted_entries);
+
+    // Everything is parsed, we don't need the sequences anymore
+    sequence_collection().swap (m_sequences);
+    m_sequence_parser_ap.reset();
+}
+
 //----------------------------------------------------------------------
 LineTable::Entry::LessThanBinaryPredicate::LessThanBinaryPredicate(LineTable *line_table) :
     m_line_table (line_table)
@@ -146,12 +262,14 @@ LineTable::GetSectionForEntryIndex (uint32_t idx)
 uint32_t
 LineTable::GetSize() const
 {
+    const_cast<LineTable *>(this)->ParseAllSequences();
     return m_entries.size();
 }
 
 bool
 LineTable::GetLineEntryAtIndex(uint32_t idx, LineEntry& line_entry)
 {
+    ParseAllSequences();
     if (idx < m_entries.size())
     {
         ConvertEntryAtIndexToLineEntry (idx, line_entry);
@@ -167,6 +285,13 @@ LineTable::FindLineEntryByAddress (const Address &so_addr, LineEntry& line_entry
     if (index_ptr != NULL )
         *index_ptr = UINT32_MAX;
 
+    // Entry indexes are only stable once everything has been parsed,
+    // so only parse the sequences we need when no index is wanted.
+    if (index_ptr != NULL)
+        ParseAllSequences();
+    else
+        ParseSequencesContainingFileAddress (so_addr.GetFileAddress());
+
     bool success = false;
     uint32_t sect_idx = m_section_list.FindSectionIndex (so_addr.GetSection());
     if (sect_idx != UINT32_MAX)
@@ -282,6 +407,7 @@ LineTable::FindLineEntryIndexByFileIndex
     LineEntry* line_entry_ptr
 )
 {
+    ParseAllSequences();
 
     const size_t count = m_entries.size();
     std::vector<uint32_t>::const_iterator begin_pos = file_indexes.begin();
@@ -333,6 +459,8 @@ LineTable::FindLineEntryIndexByFileIndex
 uint32_t
 LineTable::FindLineEntryIndexByFileIndex (uint32_t start_idx, uint32_t file_idx, uint32_t line, bool exact, LineEntry* line_entry_ptr)
 {
+    ParseAllSequences();
+
     const size_t count = m_entries.size();
     size_t best_match = UINT32_MAX;
 
@@ -381,6 +509,8 @@ LineTable::FindLineEntryIndexByFileIndex (uint32_t start_idx, uint32_t file_idx,
 void
 LineTable::Dump (Stream *s, Target *target, Address::DumpStyle style, Address::DumpStyle fallback_style, bool show_line_ranges)
 {
+    ParseAllSequences();
+
     const size_t count = m_entries.size();
     LineEntry line_entry;
     FileSpec prev_file;
@@ -397,6 +527,8 @@ LineTable::Dump (Stream *s, Target *target, Address::DumpStyle style, Address::D
 void
 LineTable::GetDescription (Stream *s, Target *target, DescriptionLevel level)
 {
+    ParseAllSequences();
+
     const size_t count = m_entries.size();
     LineEntry line_entry;
     for (size_t idx = 0; idx < count; ++idx)
@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <map>
 
 #include "lldb/Core/Module.h"
@@ -25,9 +26,11 @@ Symtab::Symtab(ObjectFile *objfile) :
     m_symbols (),
     m_addr_indexes (),
     m_name_to_index (),
+    m_sorted_name_indexes (),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_addr_indexes_computed (false),
-    m_name_indexes_computed (false)
+    m_name_indexes_computed (false),
+    m_sorted_name_indexes_computed (false)
 {
 }
 
@@ -59,10 +62,12 @@ Symtab::AddSymbol(const Symbol& symbol)
     // when calling this function to avoid performance issues.
     uint32_t symbol_idx = m_symbols.size();
     m_name_to_index.Clear();
+    m_sorted_name_indexes.clear();
     m_addr_indexes.clear();
     m_symbols.push_back(symbol);
     m_addr_indexes_computed = false;
     m_name_indexes_computed = false;
+    m_sorted_name_indexes_computed = false;
     return symbol_idx;
 }
 
@@ -313,6 +318,69 @@ Symtab::InitNameIndexes()
     }
 }
 
+struct NameAndIndexLessThan
+{
+    bool
+    operator() (const std::pair<const char *, uint32_t> &lhs, const std::pair<const char *, uint32_t> &rhs) const
+    {
+        return ::strcmp (lhs.first, rhs.first) < 0;
+    }
+
+    bool
+    operator() (const std::pair<const char *, uint32_t> &lhs, const char *rhs) const
+    {
+        return ::strcmp (lhs.first, rhs) < 0;
+    }
+};
+
+void
+Symtab::InitSortedNameIndexes ()
+{
+    // Protected function, no need to lock mutex...
+    if (!m_sorted_name_indexes_computed)
+    {
+        m_sorted_name_indexes_computed = true;
+        Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+        const size_t count = m_symbols.size();
+        m_sorted_name_indexes.reserve (count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const char *name = m_symbols[i].GetMangled().GetName().AsCString();
+            if (name)
+                m_sorted_name_indexes.push_back (NameAndIndex (name, i));
+        }
+        std::sort (m_sorted_name_indexes.begin(), m_sorted_name_indexes.end(), NameAndIndexLessThan());
+    }
+}
+
+//----------------------------------------------------------------------
+// If every match of "regex" must start with the same literal text, fill
+// in "indexes" with the indexes of the symbols whose names start with
+// that text, in symbol index order, and return true. Return false if
+// every symbol needs to be checked.
+//----------------------------------------------------------------------
+bool
+Symtab::GetSymbolIndexesWithNamePrefix (const RegularExpression &regex, std::vector<uint32_t>& indexes)
+{
+    // Protected function, no need to lock mutex...
+    const char *prefix = regex.GetRequiredPrefix();
+    if (prefix == NULL)
+        return false;
+
+    InitSortedNameIndexes ();
+
+    const size_t prefix_len = ::strlen (prefix);
+    std::vector<NameAndIndex>::const_iterator pos, begin = m_sorted_name_indexes.begin(), end = m_sorted_name_indexes.end();
+    for (pos = std::lower_bound (begin, end, prefix, NameAndIndexLessThan());
+         pos != end && ::strncmp (pos->first, prefix, prefix_len) == 0;
+         ++pos)
+    {
+        indexes.push_back (pos->second);
+    }
+    std::sort (indexes.begin(), indexes.end());
+    return true;
+}
+
 uint32_t
 Symtab::AppendSymbolIndexesWithType (SymbolType symbol_type, std::vector<uint32_t>& indexes, uint32_t start_idx, uint32_t end_index) const
 {
@@ -536,10 +604,16 @@ Symtab::AppendSymbolIndexesMatchingRegExAndType (const RegularExpression &regexp
     Mutex::Locker locker (m_mutex);
 
     uint32_t prev_size = indexes.size();
-    uint32_t sym_end = m_symbols.size();
 
-    for (int i = 0; i < sym_end; i++)
+    // Only look at the symbols whose names start with the regular
+    // expression's literal prefix if it has one
+    std::vector<uint32_t> prefix_indexes;
+    const bool use_prefix_indexes = GetSymbolIndexesWithNamePrefix (regexp, prefix_indexes);
+    const uint32_t sym_end = use_prefix_indexes ? prefix_indexes.size() : m_symbols.size();
+
+    for (uint32_t sym_idx = 0; sym_idx < sym_end; sym_idx++)
     {
+        const uint32_t i = use_prefix_indexes ? prefix_indexes[sym_idx] : sym_idx;
         if (symbol_type == eSymbolTypeAny || m_symbols[i].GetType() == symbol_type)
         {
             const char *name = m_symbols[i].GetMangled().GetName().AsCString();
@@ -560,10 +634,16 @@ Symtab::AppendSymbolIndexesMatchingRegExAndType (const RegularExpression &regexp
     Mutex::Locker locker (m_mutex);
 
     uint32_t prev_size = indexes.size();
-    uint32_t sym_end = m_symbols.size();
 
-    for (int i = 0; i < sym_end; i++)
+    // Only look at the symbols whose names start with the regular
+    // expression's literal prefix if it has one
+    std::vector<uint32_t> prefix_indexes;
+    const bool use_prefix_indexes = GetSymbolIndexesWithNamePrefix (regexp, prefix_indexes);
+    const uint32_t sym_end = use_prefix_indexes ? prefix_indexes.size() : m_symbols.size();
+
+    for (uint32_t sym_idx = 0; sym_idx < sym_end; sym_idx++)
     {
+        const uint32_t i = use_prefix_indexes ? prefix_indexes[sym_idx] : sym_idx;
         if (symbol_type == eSymbolTypeAny || m_symbols[i].GetType() == symbol_type)
         {
             if (CheckSymbolAtIndex(i, symbol_debug_type, symbol_visibility) == false)
@@ -32,6 +32,8 @@ using namespace lldb_private;
 UnwindTable::UnwindTable (ObjectFile& objfile) : 
     m_object_file (objfile), 
     m_unwinds (),
+    m_unwind_rows_mutex (Mutex::eMutexTypeNormal),
+    m_unwind_rows (),
     m_initialized (false),
     m_eh_frame (NULL),
     m_assembly_profiler (NULL)
@@ -110,6 +112,33 @@ UnwindTable::GetFuncUnwindersContainingAddress (const Address& addr, SymbolConte
     return func_unwinder_sp;
 }
 
+bool
+UnwindTable::GetCachedUnwindRow (lldb::addr_t file_addr, CachedUnwindRow &cached_row) const
+{
+    Mutex::Locker locker (m_unwind_rows_mutex);
+    unwind_row_collection::const_iterator pos = m_unwind_rows.find (file_addr);
+    if (pos == m_unwind_rows.end())
+        return false;
+    cached_row = pos->second;
+    return true;
+}
+
+void
+UnwindTable::SetCachedUnwindRow (lldb::addr_t file_addr, const CachedUnwindRow &cached_row)
+{
+    Mutex::Locker locker (m_unwind_rows_mutex);
+    // Rows are cheap to find again, so rather than tracking which ones
+    // are in use just start over when the cache gets big
+    if (m_unwind_rows.size() >= kMaxCachedUnwindRows)
+        m_unwind_rows.clear();
+
+    CachedUnwindRow &row = m_unwind_rows[file_addr];
+    row = cached_row;
+    // Don't let the module that owns us keep itself alive
+    row.sym_ctx.module_sp.reset();
+    row.sym_ctx.target_sp.reset();
+}
+
 void
 UnwindTable::Dump (Stream &s)
 {
@@ -176,6 +176,65 @@ Process::MemoryCache::Read
     return dst_len - bytes_left;
 }
 
+// Cache lines that are this many lines apart or closer get read with one
+// memory read, and no single read is larger than g_max_prefetch_lines lines.
+static const uint32_t g_max_prefetch_gap_lines = 4;
+static const uint32_t g_max_prefetch_lines = 16;
+
+void
+Process::MemoryCache::Prefetch (Process *process, const std::vector<addr_t> &addrs)
+{
+    if (addrs.empty())
+        return;
+
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    Mutex::Locker locker (m_cache_mutex);
+
+    // Find the cache lines we don't have yet
+    std::vector<addr_t> line_addrs;
+    for (std::vector<addr_t>::const_iterator pos = addrs.begin(), end = addrs.end(); pos != end; ++pos)
+    {
+        if (*pos == LLDB_INVALID_ADDRESS || *pos == 0)
+            continue;
+        const addr_t line_addr = *pos - (*pos % cache_line_byte_size);
+        if (m_cache.find (line_addr) == m_cache.end())
+            line_addrs.push_back (line_addr);
+    }
+    std::sort (line_addrs.begin(), line_addrs.end());
+    line_addrs.erase (std::unique (line_addrs.begin(), line_addrs.end()), line_addrs.end());
+
+    const size_t num_lines = line_addrs.size();
+    size_t run_start_idx = 0;
+    while (run_start_idx < num_lines)
+    {
+        // Grow a run of nearby lines that we can read all at once
+        const addr_t run_start_addr = line_addrs[run_start_idx];
+        size_t run_end_idx = run_start_idx + 1;
+        while (run_end_idx < num_lines &&
+               line_addrs[run_end_idx] - line_addrs[run_end_idx - 1] <= g_max_prefetch_gap_lines * cache_line_byte_size &&
+               line_addrs[run_end_idx] - run_start_addr < g_max_prefetch_lines * cache_line_byte_size)
+            ++run_end_idx;
+
+        const size_t run_byte_size = line_addrs[run_end_idx - 1] + cache_line_byte_size - run_start_addr;
+        DataBufferHeap run_buffer (run_byte_size, 0);
+        Error error;
+        const size_t bytes_read = process->ReadMemoryFromInferior (run_start_addr,
+                                                                   run_buffer.GetBytes(),
+                                                                   run_buffer.GetByteSize(),
+                                                                   error);
+
+        // Only cache the lines we got all of, Read() will read any partial
+        // lines on its own
+        for (size_t offset = 0; offset + cache_line_byte_size <= bytes_read; offset += cache_line_byte_size)
+        {
+            const addr_t line_addr = run_start_addr + offset;
+            if (m_cache.find (line_addr) == m_cache.end())
+                m_cache[line_addr] = DataBufferSP (new DataBufferHeap (run_buffer.GetBytes() + offset, cache_line_byte_size));
+        }
+        run_start_idx = run_end_idx;
+    }
+}
+
 Process*
 Process::FindPlugin (Target &target, const char *plugin_name, Listener &listener)
 {
@@ -1267,6 +1326,51 @@ Process::ReadMemory (addr_t addr, void *buf, size_t size, Error &error)
 
 #endif  // #else for #if defined (ENABLE_MEMORY_CACHING)
 
+void
+Process::PrefetchMemory (const std::vector<addr_t> &addrs)
+{
+#if defined (ENABLE_MEMORY_CACHING)
+    m_memory_cache.Prefetch (this, addrs);
+#endif
+}
+
+bool
+Process::ReadCStringFromMemory (addr_t addr, std::string &out_str, size_t max_length, Error &error)
+{
+    out_str.clear();
+
+    // Never read past the end of the cache line that the string continues
+    // into, since that would read memory that might not be mapped and would
+    // bypass the memory cache
+    const size_t chunk_size = m_memory_cache.GetCacheLineByteSize();
+    std::vector<char> chunk (chunk_size);
+    addr_t curr_addr = addr;
+    while (out_str.size() < max_length)
+    {
+        size_t curr_size = chunk_size - (curr_addr % chunk_size);
+        if (curr_size > max_length - out_str.size())
+            curr_size = max_length - out_str.size();
+
+        const size_t bytes_read = ReadMemory (curr_addr, &chunk.front(), curr_size, error);
+        const char *nul = (const char *)::memchr (&chunk.front(), '\0', bytes_read);
+        if (nul)
+        {
+            out_str.append (&chunk.front(), nul - &chunk.front());
+            return true;
+        }
+        out_str.append (&chunk.front(), bytes_read);
+
+        if (bytes_read < curr_size)
+        {
+            if (error.Success())
+                error.SetErrorStringWithFormat ("unable to read memory at 0x%llx", (uint64_t)(curr_addr + bytes_read));
+            return false;
+        }
+        curr_addr += bytes_read;
+    }
+    return false;
+}
+
 
 size_t
 Process::ReadMemoryFromInferior (addr_t addr, void *buf, size_t size, Error &error)
@@ -950,6 +950,21 @@ StackFrame::UpdatePreviousFrameFromCurrentFrame (StackFrame &curr_frame)
 }
     
 
+void
+StackFrame::ReuseFrameFromPreviousStop (uint32_t frame_idx, uint32_t concrete_frame_idx)
+{
+    m_frame_index = frame_idx;
+    m_concrete_frame_index = concrete_frame_idx;
+    // The register context belongs to the previous stop's unwinder, we will
+    // lazily get a new one if anyone asks for it.
+    m_reg_context_sp.reset();
+    // The symbol context is still good, but the frame base comes from the
+    // register context
+    m_flags.Clear(GOT_FRAME_BASE);
+    m_frame_base.Clear();
+    m_frame_base_error.Clear();
+}
+
 bool
 StackFrame::HasCachedData () const
 {
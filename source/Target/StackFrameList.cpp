@@ -73,102 +73,90 @@ StackFrameList::GetNumFrames (bool can_create)
             // we need to calculate all concrete frames first, then iterate
             // through all of them and count up how many inlined functions are
             // in each frame. 
-            const uint32_t unwind_frame_count = unwinder->GetFrameCount();
-            
             StackFrameSP unwind_frame_sp;
-            for (uint32_t idx=0; idx<unwind_frame_count; ++idx)
+
+            // We might have already created frame zero, only create it
+            // if we need to
+            if (m_frames.empty())
             {
-                if (idx == 0)
-                {
-                    // We might have already created frame zero, only create it
-                    // if we need to
-                    if (m_frames.empty())
-                    {
-                        cfa = m_thread.m_reg_context_sp->GetSP();
-                        m_thread.GetRegisterContext();
-                        unwind_frame_sp.reset (new StackFrame (m_frames.size(), 
-                                                               idx, 
-                                                               m_thread, 
-                                                               m_thread.m_reg_context_sp, 
-                                                               cfa, 
-                                                               m_thread.m_reg_context_sp->GetPC(), 
-                                                               NULL));
-                        m_frames.push_back (unwind_frame_sp);
-                    }
-                    else
-                    {
-                        unwind_frame_sp = m_frames.front();
-                        cfa = unwind_frame_sp->m_id.GetCallFrameAddress();
-                    }
-                }
-                else
-                {
-                    const bool success = unwinder->GetFrameInfoAtIndex(idx, cfa, pc);
-                    assert (success);
-                    unwind_frame_sp.reset (new StackFrame (m_frames.size(), idx, m_thread, cfa, pc, NULL));
-                    m_frames.push_back (unwind_frame_sp);
-                }
+                cfa = m_thread.m_reg_context_sp->GetSP();
+                m_thread.GetRegisterContext();
+                unwind_frame_sp.reset (new StackFrame (m_frames.size(), 
+                                                       0, 
+                                                       m_thread, 
+                                                       m_thread.m_reg_context_sp, 
+                                                       cfa, 
+                                                       m_thread.m_reg_context_sp->GetPC(), 
+                                                       NULL));
+                m_frames.push_back (unwind_frame_sp);
+            }
+            else
+            {
+                unwind_frame_sp = m_frames.front();
+                cfa = unwind_frame_sp->m_id.GetCallFrameAddress();
+            }
+            AppendInlinedFrames (unwind_frame_sp, 0, cfa);
+
+            // If the previous stop's frames are still on the stack above the
+            // frames that changed (e.g. we are stepping within a function),
+            // we stop at the first concrete frame that matches and reuse all
+            // of the previous frames from there up.  A matching CFA and pc
+            // doesn't mean the callers are the same (the same function can
+            // be called at the same depth from somewhere else), so the rest
+            // of the unwind has to agree with the previous frames before we
+            // reuse them.  If it doesn't, we unwind everything.
+            size_t curr_reused_idx = UINT32_MAX;
+            size_t prev_reused_idx = UINT32_MAX;
+            std::vector<size_t> prev_concrete_frame_idxs;
+            if (m_prev_frames_sp)
+                m_prev_frames_sp->GetConcreteFrameIndexes (prev_concrete_frame_idxs);
+            
+            // Frame zero's CFA is the stack pointer, not the real CFA, so
+            // start looking for a match at previous concrete frame one
+            size_t prev_concrete_pos = 1;
+            bool try_reuse = prev_concrete_frame_idxs.size() > 1;
 
-                Block *unwind_block = unwind_frame_sp->GetSymbolContext (eSymbolContextBlock).block;
-                
-                if (unwind_block)
+            for (uint32_t idx=1; unwinder->GetFrameInfoAtIndex(idx, cfa, pc); ++idx)
+            {
+                // The CFAs of the previous concrete frames increase as we go
+                // up the stack, so skip any that are below this CFA
+                while (prev_concrete_pos < prev_concrete_frame_idxs.size() &&
+                       m_prev_frames_sp->m_frames[prev_concrete_frame_idxs[prev_concrete_pos]]->GetStackID().GetCallFrameAddress() < cfa)
+                    ++prev_concrete_pos;
+
+                if (try_reuse && prev_concrete_pos < prev_concrete_frame_idxs.size())
                 {
-                    Block *inlined_block = unwind_block->GetContainingInlinedBlock();
-                    if (inlined_block)
+                    const size_t prev_idx = prev_concrete_frame_idxs[prev_concrete_pos];
+                    const StackID &prev_stack_id = m_prev_frames_sp->m_frames[prev_idx]->GetStackID();
+                    if (prev_stack_id.GetCallFrameAddress() == cfa && prev_stack_id.GetPC() == pc)
                     {
-                        for (; inlined_block != NULL; inlined_block = inlined_block->GetInlinedParent ())
+                        if (PreviousCallersMatch (prev_concrete_frame_idxs, prev_concrete_pos, idx))
                         {
-                            SymbolContext inline_sc;
-                            Block *parent_block = inlined_block->GetInlinedParent();
-
-                            const bool is_inlined_frame = parent_block != NULL;
-                        
-                            if (parent_block == NULL)
-                                parent_block = inlined_block->GetParent();
-                            
-                            parent_block->CalculateSymbolContext (&inline_sc);
-                        
-                            Address previous_frame_lookup_addr (m_frames.back()->GetFrameCodeAddress());
-                            if (unwind_frame_sp->GetFrameIndex() > 0 && m_frames.back().get() == unwind_frame_sp.get())
-                                previous_frame_lookup_addr.Slide (-1);
-                        
-                            AddressRange range;
-                            inlined_block->GetRangeContainingAddress (previous_frame_lookup_addr, range);
-                        
-                            const InlineFunctionInfo* inline_info = inlined_block->GetInlinedFunctionInfo();
-                            assert (inline_info);
-                            inline_sc.line_entry.range.GetBaseAddress() = m_frames.back()->GetFrameCodeAddress();
-                            inline_sc.line_entry.file = inline_info->GetCallSite().GetFile();
-                            inline_sc.line_entry.line = inline_info->GetCallSite().GetLine();
-                            inline_sc.line_entry.column = inline_info->GetCallSite().GetColumn();
-                                            
-                            StackFrameSP frame_sp(new StackFrame (m_frames.size(),
-                                                                  idx,
-                                                                  m_thread,
-                                                                  unwind_frame_sp->GetRegisterContextSP (),
-                                                                  cfa,
-                                                                  range.GetBaseAddress(),
-                                                                  &inline_sc));                                           // The symbol context for this inline frame
-                            
-                            if (is_inlined_frame)
-                            {
-                                // Use the block with the inlined function info
-                                // as the symbol context since we want this frame
-                                // to have only the variables for the inlined function
-                                frame_sp->SetSymbolContextScope (parent_block);
-                            }
-                            else
+                            curr_reused_idx = m_frames.size();
+                            prev_reused_idx = prev_idx;
+                            const uint32_t prev_concrete_idx = m_prev_frames_sp->m_frames[prev_idx]->GetConcreteFrameIndex();
+                            const size_t prev_num_frames = m_prev_frames_sp->m_frames.size();
+                            for (size_t i = prev_idx; i < prev_num_frames; ++i)
                             {
-                                // This block is not inlined with means it has no
-                                // inlined parents either, so we want to use the top
-                                // most function block.
-                                frame_sp->SetSymbolContextScope (&unwind_frame_sp->GetSymbolContext (eSymbolContextFunction).function->GetBlock(false));
+                                StackFrameSP prev_frame_sp (m_prev_frames_sp->m_frames[i]);
+                                prev_frame_sp->ReuseFrameFromPreviousStop (m_frames.size(), 
+                                                                           idx + prev_frame_sp->GetConcreteFrameIndex() - prev_concrete_idx);
+                                m_frames.push_back (prev_frame_sp);
                             }
-                            
-                            m_frames.push_back (frame_sp);
+#if defined (DEBUG_STACK_FRAMES)
+                            s.Printf("\n    Reusing previous frames from #%zu as #%zu", prev_reused_idx, curr_reused_idx);
+#endif
+                            break;
                         }
+                        // The callers changed, so don't trust any of the
+                        // previous frames
+                        try_reuse = false;
                     }
                 }
+
+                unwind_frame_sp.reset (new StackFrame (m_frames.size(), idx, m_thread, cfa, pc, NULL));
+                m_frames.push_back (unwind_frame_sp);
+                AppendInlinedFrames (unwind_frame_sp, idx, cfa);
             }
 
             if (m_prev_frames_sp)
@@ -185,7 +173,20 @@ StackFrameList::GetNumFrames (bool can_create)
 #endif
                 size_t curr_frame_num, prev_frame_num;
                 
-                for (curr_frame_num = curr_frames->m_frames.size(), prev_frame_num = prev_frames->m_frames.size();
+                // Frames we reused above are already the previous frames, 
+                // so only merge the frames below them
+                if (curr_reused_idx != UINT32_MAX)
+                {
+                    curr_frame_num = curr_reused_idx;
+                    prev_frame_num = prev_reused_idx;
+                }
+                else
+                {
+                    curr_frame_num = curr_frames->m_frames.size();
+                    prev_frame_num = prev_frames->m_frames.size();
+                }
+
+                for (;
                      curr_frame_num > 0 && prev_frame_num > 0;
                      --curr_frame_num, --prev_frame_num)
                 {
@@ -245,6 +246,126 @@ StackFrameList::GetNumFrames (bool can_create)
     return m_frames.size();
 }
 
+//----------------------------------------------------------------------
+// Append a frame for each inlined function that contains the pc of the
+// concrete frame "unwind_frame_sp" (which must be the last frame in
+// m_frames).
+//----------------------------------------------------------------------
+void
+StackFrameList::AppendInlinedFrames (const StackFrameSP &unwind_frame_sp, uint32_t unwind_idx, addr_t cfa)
+{
+    Block *unwind_block = unwind_frame_sp->GetSymbolContext (eSymbolContextBlock).block;
+    
+    if (unwind_block)
+    {
+        Block *inlined_block = unwind_block->GetContainingInlinedBlock();
+        if (inlined_block)
+        {
+            for (; inlined_block != NULL; inlined_block = inlined_block->GetInlinedParent ())
+            {
+                SymbolContext inline_sc;
+                Block *parent_block = inlined_block->GetInlinedParent();
+
+                const bool is_inlined_frame = parent_block != NULL;
+            
+                if (parent_block == NULL)
+                    parent_block = inlined_block->GetParent();
+                
+                parent_block->CalculateSymbolContext (&inline_sc);
+            
+                Address previous_frame_lookup_addr (m_frames.back()->GetFrameCodeAddress());
+                if (unwind_frame_sp->GetFrameIndex() > 0 && m_frames.back().get() == unwind_frame_sp.get())
+                    previous_frame_lookup_addr.Slide (-1);
+            
+                AddressRange range;
+                inlined_block->GetRangeContainingAddress (previous_frame_lookup_addr, range);
+            
+                const InlineFunctionInfo* inline_info = inlined_block->GetInlinedFunctionInfo();
+                assert (inline_info);
+                inline_sc.line_entry.range.GetBaseAddress() = m_frames.back()->GetFrameCodeAddress();
+                inline_sc.line_entry.file = inline_info->GetCallSite().GetFile();
+                inline_sc.line_entry.line = inline_info->GetCallSite().GetLine();
+                inline_sc.line_entry.column = inline_info->GetCallSite().GetColumn();
+                                
+                StackFrameSP frame_sp(new StackFrame (m_frames.size(),
+                                                      unwind_idx,
+                                                      m_thread,
+                                                      unwind_frame_sp->GetRegisterContextSP (),
+                                                      cfa,
+                                                      range.GetBaseAddress(),
+                                                      &inline_sc));                                           // The symbol context for this inline frame
+                
+                if (is_inlined_frame)
+                {
+                    // Use the block with the inlined function info
+                    // as the symbol context since we want this frame
+                    // to have only the variables for the inlined function
+                    frame_sp->SetSymbolContextScope (parent_block);
+                }
+                else
+                {
+                    // This block is not inlined with means it has no
+                    // inlined parents either, so we want to use the top
+                    // most function block.
+                    frame_sp->SetSymbolContextScope (&unwind_frame_sp->GetSymbolContext (eSymbolContextFunction).function->GetBlock(false));
+                }
+                
+                m_frames.push_back (frame_sp);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+// Check that the unwinder finds the same callers, and no more frames,
+// above concrete frame "unwind_idx" as the previous stop's frames have
+// above the concrete frame at "prev_concrete_pos" in
+// "prev_concrete_frame_idxs".
+//----------------------------------------------------------------------
+bool
+StackFrameList::PreviousCallersMatch (const std::vector<size_t> &prev_concrete_frame_idxs,
+                                      size_t prev_concrete_pos,
+                                      uint32_t unwind_idx)
+{
+    Unwind *unwinder = m_thread.GetUnwinder ();
+    addr_t cfa = LLDB_INVALID_ADDRESS;
+    addr_t pc = LLDB_INVALID_ADDRESS;
+    const size_t num_prev_concrete_frames = prev_concrete_frame_idxs.size();
+    for (size_t pos = prev_concrete_pos + 1; pos < num_prev_concrete_frames; ++pos)
+    {
+        if (!unwinder->GetFrameInfoAtIndex(++unwind_idx, cfa, pc))
+            return false;
+        const StackID &prev_stack_id = m_prev_frames_sp->m_frames[prev_concrete_frame_idxs[pos]]->GetStackID();
+        if (prev_stack_id.GetCallFrameAddress() != cfa || prev_stack_id.GetPC() != pc)
+            return false;
+    }
+    return !unwinder->GetFrameInfoAtIndex(++unwind_idx, cfa, pc);
+}
+
+//----------------------------------------------------------------------
+// Get the indexes into m_frames of the concrete (unwound) frames. The
+// concrete frame always comes before the inlined frames that share its
+// concrete frame index. Returns false if not all frames were created.
+//----------------------------------------------------------------------
+bool
+StackFrameList::GetConcreteFrameIndexes (std::vector<size_t> &concrete_frame_idxs)
+{
+    Mutex::Locker locker (m_mutex);
+    concrete_frame_idxs.clear();
+    const size_t num_frames = m_frames.size();
+    for (size_t i=0; i<num_frames; ++i)
+    {
+        if (m_frames[i].get() == NULL)
+        {
+            concrete_frame_idxs.clear();
+            return false;
+        }
+        if (i == 0 || m_frames[i]->GetConcreteFrameIndex() != m_frames[i-1]->GetConcreteFrameIndex())
+            concrete_frame_idxs.push_back (i);
+    }
+    return true;
+}
+
 void
 StackFrameList::Dump (Stream *s)
 {
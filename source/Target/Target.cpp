@@ -240,6 +240,19 @@ Target::CreateBreakpoint (FileSpec *containingModule, RegularExpression &func_re
     return CreateBreakpoint (filter_sp, resolver_sp, internal);
 }
 
+BreakpointSP
+Target::CreateFuncGlobBreakpoint (FileSpec *containingModule, const char *func_glob, bool internal)
+{
+    BreakpointSP bp_sp;
+    if (func_glob && func_glob[0])
+    {
+        SearchFilterSP filter_sp(GetSearchFilterForModule (containingModule));
+        BreakpointResolverSP resolver_sp (new BreakpointResolverName (NULL, func_glob, eFunctionNameTypeAuto, Breakpoint::Glob));
+        bp_sp = CreateBreakpoint (filter_sp, resolver_sp, internal);
+    }
+    return bp_sp;
+}
+
 BreakpointSP
 Target::CreateBreakpoint (SearchFilterSP &filter_sp, BreakpointResolverSP &resolver_sp, bool internal)
 {
@@ -996,6 +1009,7 @@ Target::SettingsController::CreateInstanceSettings (const char *instance_name)
 #define TSC_EXEC_LEVEL      "execution-level"
 #define TSC_EXEC_MODE       "execution-mode"
 #define TSC_EXEC_OS_TYPE    "execution-os-type"
+#define TSC_MAX_STR_SUMMARY "max-string-summary-length"
 
 
 static const ConstString &
@@ -1034,6 +1048,13 @@ GetSettingNameForExecutionOSType ()
     return g_const_string;
 }
 
+static const ConstString &
+GetSettingNameForMaxStringSummaryLength ()
+{
+    static ConstString g_const_string (TSC_MAX_STR_SUMMARY);
+    return g_const_string;
+}
+
 
 bool
 Target::SettingsController::SetGlobalVariable (const ConstString &var_name,
@@ -1086,7 +1107,8 @@ TargetInstanceSettings::TargetInstanceSettings
     m_expr_prefix_contents (),
     m_execution_level (eExecutionLevelAuto),
     m_execution_mode (eExecutionModeAuto),
-    m_execution_os_type (eExecutionOSTypeAuto)
+    m_execution_os_type (eExecutionOSTypeAuto),
+    m_max_string_summary_length (1024)
 {
     // CopyInstanceSettings is a pure virtual function in InstanceSettings; it therefore cannot be called
     // until the vtables for TargetInstanceSettings are properly set up, i.e. AFTER all the initializers.
@@ -1204,6 +1226,18 @@ TargetInstanceSettings::UpdateInstanceSettingsVariable (const ConstString &var_n
         if (err.Success())
             m_execution_os_type = (ExecutionOSType)new_enum;
     }
+    else if (var_name == GetSettingNameForMaxStringSummaryLength ())
+    {
+        char *end = NULL;
+        const uint32_t max_length = ::strtoul (value ? value : "", &end, 0);
+        if (value && value[0] && end && end[0] == '\0')
+            m_max_string_summary_length = max_length;
+        else
+        {
+            err.SetErrorToGenericError ();
+            err.SetErrorStringWithFormat ("'%s' is not a valid unsigned integer string.\n", value ? value : "");
+        }
+    }
 }
 
 void
@@ -1219,6 +1253,7 @@ TargetInstanceSettings::CopyInstanceSettings (const lldb::InstanceSettingsSP &ne
     m_execution_level       = new_settings_ptr->m_execution_level;
     m_execution_mode        = new_settings_ptr->m_execution_mode;
     m_execution_os_type     = new_settings_ptr->m_execution_os_type;
+    m_max_string_summary_length = new_settings_ptr->m_max_string_summary_length;
 }
 
 bool
@@ -1243,6 +1278,12 @@ TargetInstanceSettings::GetInstanceSettingsValue (const SettingEntry &entry,
     {
         value.AppendString (UserSettingsController::EnumToString (entry.enum_values, m_execution_os_type));
     }
+    else if (var_name == GetSettingNameForMaxStringSummaryLength ())
+    {
+        StreamString max_length_str;
+        max_length_str.Printf ("%u", m_max_string_summary_length);
+        value.AppendString (max_length_str.GetData());
+    }
     else 
     {
         if (err)
@@ -1319,5 +1360,6 @@ Target::SettingsController::instance_settings_table[] =
     { TSC_EXEC_LEVEL    , eSetVarTypeEnum   , "auto"    , g_execution_level_enums   , false, false, "Sets the execution level for a target." },
     { TSC_EXEC_MODE     , eSetVarTypeEnum   , "auto"    , g_execution_mode_enums    , false, false, "Sets the execution mode for a target." },
     { TSC_EXEC_OS_TYPE  , eSetVarTypeEnum   , "auto"    , g_execution_os_enums      , false, false, "Sets the execution OS for a target." },
+    { TSC_MAX_STR_SUMMARY, eSetVarTypeInt   , "1024"    , NULL                      , false, false, "The maximum number of characters to show in the summary of a C string." },
     {  NULL             , eSetVarTypeNone   , NULL      , NULL                      , false, false, NULL }
 };
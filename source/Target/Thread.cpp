@@ -1121,7 +1121,8 @@ Thread::SettingsController::CreateInstanceSettings (const char *instance_name)
 ThreadInstanceSettings::ThreadInstanceSettings (UserSettingsController &owner, bool live_instance, const char *name) :
     InstanceSettings (owner, name ? name : InstanceSettings::InvalidName().AsCString(), live_instance), 
     m_avoid_regexp_ap (),
-    m_trace_enabled (false)
+    m_trace_enabled (false),
+    m_frame_pointer_unwind (false)
 {
     // CopyInstanceSettings is a pure virtual function in InstanceSettings; it therefore cannot be called
     // until the vtables for ThreadInstanceSettings are properly set up, i.e. AFTER all the initializers.
@@ -1145,7 +1146,8 @@ ThreadInstanceSettings::ThreadInstanceSettings (UserSettingsController &owner, b
 ThreadInstanceSettings::ThreadInstanceSettings (const ThreadInstanceSettings &rhs) :
     InstanceSettings (*Thread::GetSettingsController(), CreateInstanceName().AsCString()),
     m_avoid_regexp_ap (),
-    m_trace_enabled (rhs.m_trace_enabled)
+    m_trace_enabled (rhs.m_trace_enabled),
+    m_frame_pointer_unwind (rhs.m_frame_pointer_unwind)
 {
     if (m_instance_name != InstanceSettings::GetDefaultName())
     {
@@ -1172,6 +1174,7 @@ ThreadInstanceSettings::operator= (const ThreadInstanceSettings &rhs)
             m_avoid_regexp_ap.reset(NULL);
     }
     m_trace_enabled = rhs.m_trace_enabled;
+    m_frame_pointer_unwind = rhs.m_frame_pointer_unwind;
     return *this;
 }
 
@@ -1220,6 +1223,11 @@ ThreadInstanceSettings::UpdateInstanceSettingsVariable (const ConstString &var_n
         }
 
     }
+    else if (var_name == FramePointerUnwindVarName())
+    {
+        // The thread picks this up the next time it resumes
+        UserSettingsController::UpdateBooleanVariable (op, m_frame_pointer_unwind, value, err);
+    }
 }
 
 void
@@ -1234,6 +1242,7 @@ ThreadInstanceSettings::CopyInstanceSettings (const lldb::InstanceSettingsSP &ne
         m_avoid_regexp_ap.reset (new RegularExpression (new_process_settings->GetSymbolsToAvoidRegexp()->GetText()));
     else 
         m_avoid_regexp_ap.reset ();
+    m_frame_pointer_unwind = new_process_settings->GetFramePointerUnwindEnabled();
 }
 
 bool
@@ -1257,6 +1266,10 @@ ThreadInstanceSettings::GetInstanceSettingsValue (const SettingEntry &entry,
     {
         value.AppendString(m_trace_enabled ? "true" : "false");
     }
+    else if (var_name == FramePointerUnwindVarName())
+    {
+        value.AppendString(m_frame_pointer_unwind ? "true" : "false");
+    }
     else
     {
         if (err)
@@ -1295,6 +1308,14 @@ ThreadInstanceSettings::GetTraceThreadVarName ()
     return trace_thread_var_name;
 }
 
+const ConstString &
+ThreadInstanceSettings::FramePointerUnwindVarName ()
+{
+    static ConstString frame_pointer_unwind_var_name ("frame-pointer-unwind");
+
+    return frame_pointer_unwind_var_name;
+}
+
 //--------------------------------------------------
 // SettingsController Variable Tables
 //--------------------------------------------------
@@ -1313,5 +1334,6 @@ Thread::SettingsController::instance_settings_table[] =
   //{ "var-name",    var-type,              "default",      enum-table, init'd, hidden, "help-text"},
     { "step-avoid-regexp",  eSetVarTypeString,      "",  NULL,       false,  false,  "A regular expression defining functions step-in won't stop in." },
     { "trace-thread",  eSetVarTypeBoolean,      "false",  NULL,       false,  false,  "If true, this thread will single-step and log execution." },
+    { "frame-pointer-unwind",  eSetVarTypeBoolean,  "false",  NULL,       false,  false,  "If true, backtraces walk the frame pointer chain and only use the full unwinder when the chain looks wrong (Linux i386 and x86_64 only)." },
     {  NULL, eSetVarTypeNone, NULL, NULL, 0, 0, NULL }
 };
@@ -87,3 +87,31 @@ StringExtractorGDBRemote::GetError ()
     }
     return 0;
 }
+
+size_t
+StringExtractorGDBRemote::DecodeRunLengthEncoding ()
+{
+    if (m_packet.find('*') == std::string::npos)
+        return 0;
+
+    const size_t encoded_size = m_packet.size();
+    std::string decoded;
+    decoded.reserve (encoded_size * 2);
+    for (size_t i = 0; i < encoded_size; ++i)
+    {
+        const char ch = m_packet[i];
+        if (ch == '*' && !decoded.empty() && i + 1 < encoded_size)
+        {
+            const uint8_t count_char = m_packet[++i];
+            if (count_char > 29)
+                decoded.append (count_char - 29, decoded[decoded.size() - 1]);
+        }
+        else
+        {
+            decoded.append (1, ch);
+        }
+    }
+    m_packet.swap (decoded);
+    m_index = 0;
+    return m_packet.size() - encoded_size;
+}
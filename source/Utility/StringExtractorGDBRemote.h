@@ -68,6 +68,14 @@ public:
     // digits. Otherwise the error encoded in XX is returned.
     uint8_t
     GetError();
+
+    // Expand run-length encoded data in the packet, where "X*N" stands
+    // for the character X followed by N - 29 more copies of it. This is
+    // only valid for packets from a remote server that agreed to send
+    // them (see "qSupported"), since '*' is otherwise a normal character.
+    // Returns the number of bytes the packet grew by.
+    size_t
+    DecodeRunLengthEncoding ();
 };
 
 #endif  // utility_StringExtractorGDBRemote_h_
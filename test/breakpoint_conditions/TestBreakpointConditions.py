@@ -25,6 +25,20 @@ class BreakpointConditionsTestCase(TestBase):
         self.buildDsym()
         self.breakpoint_conditions_python()
 
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    def test_with_dsym_interpreted_and_jit_conditions(self):
+        """Test conditions that lldb interprets and conditions that run in the target."""
+        self.buildDsym()
+        self.breakpoint_conditions_interpreted_and_jit()
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    def test_with_dsym_and_reused_condition(self):
+        """Test that a condition whose code is reused is evaluated again on every hit."""
+        self.buildDsym()
+        self.breakpoint_conditions_reused()
+
     def test_with_dwarf_and_run_command(self):
         """Exercise breakpoint condition with 'breakpoint modify -c <expr> id'."""
         self.buildDwarf()
@@ -36,6 +50,18 @@ class BreakpointConditionsTestCase(TestBase):
         self.buildDwarf()
         self.breakpoint_conditions_python()
 
+    @python_api_test
+    def test_with_dwarf_interpreted_and_jit_conditions(self):
+        """Test conditions that lldb interprets and conditions that run in the target."""
+        self.buildDwarf()
+        self.breakpoint_conditions_interpreted_and_jit()
+
+    @python_api_test
+    def test_with_dwarf_and_reused_condition(self):
+        """Test that a condition whose code is reused is evaluated again on every hit."""
+        self.buildDwarf()
+        self.breakpoint_conditions_reused()
+
     def setUp(self):
         # Call super's setUp().
         TestBase.setUp(self)
@@ -146,8 +172,10 @@ class BreakpointConditionsTestCase(TestBase):
         self.assertTrue(self.process.IsValid(), PROCESS_IS_VALID)
 
         # Frame #0 should be on self.line1 and the break condition should hold.
+        # 'val == 3' is simple enough for lldb to interpret, so the thread
+        # stops for the breakpoint rather than for a condition thread plan.
         from lldbutil import get_stopped_thread
-        thread = get_stopped_thread(self.process, lldb.eStopReasonPlanComplete)
+        thread = get_stopped_thread(self.process, lldb.eStopReasonBreakpoint)
         self.assertTrue(thread != None, "There should be a thread stopped due to breakpoint condition")
         frame0 = thread.GetFrameAtIndex(0)
         var = frame0.FindValue('val', lldb.eValueTypeVariableArgument)
@@ -159,6 +187,96 @@ class BreakpointConditionsTestCase(TestBase):
 
         self.process.Continue()
 
+    def breakpoint_conditions_interpreted_and_jit(self):
+        """Test conditions that lldb interprets and conditions that run in the target."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target.IsValid(), VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByName('c', 'a.out')
+        self.assertTrue(breakpoint.IsValid() and
+                        breakpoint.GetNumLocations() == 1,
+                        VALID_BREAKPOINT)
+
+        from lldbutil import get_stopped_thread
+
+        # Conditions lldb can interpret are tested without running the
+        # target, and the thread stops for the breakpoint itself.
+        for condition in ['val == 3', 'val * 2 > 5 && val != 4']:
+            breakpoint.SetCondition(condition)
+
+            error = lldb.SBError()
+            self.process = target.Launch (self.dbg.GetListener(), None, None, os.ctermid(), os.ctermid(), os.ctermid(), None, 0, False, error)
+            self.process = target.GetProcess()
+            self.assertTrue(self.process.IsValid(), PROCESS_IS_VALID)
+
+            thread = get_stopped_thread(self.process, lldb.eStopReasonBreakpoint)
+            self.assertTrue(thread != None,
+                            "The interpreted condition '%s' should stop for the breakpoint" % condition)
+            var = thread.GetFrameAtIndex(0).FindValue('val', lldb.eValueTypeVariableArgument)
+            self.assertTrue(var.GetValue(thread.GetFrameAtIndex(0)) == '3',
+                            "The condition '%s' should stop when val is 3" % condition)
+
+            self.process.Kill()
+
+        # A condition that calls a function has to be JIT compiled and run
+        # in the target, the thread stops when that thread plan completes.
+        breakpoint.SetCondition('identity(val) == 3')
+
+        error = lldb.SBError()
+        self.process = target.Launch (self.dbg.GetListener(), None, None, os.ctermid(), os.ctermid(), os.ctermid(), None, 0, False, error)
+        self.process = target.GetProcess()
+        self.assertTrue(self.process.IsValid(), PROCESS_IS_VALID)
+
+        thread = get_stopped_thread(self.process, lldb.eStopReasonPlanComplete)
+        self.assertTrue(thread != None,
+                        "The JIT compiled condition should stop when its thread plan completes")
+        frame0 = thread.GetFrameAtIndex(0)
+        var = frame0.FindValue('val', lldb.eValueTypeVariableArgument)
+        self.assertTrue(frame0.GetLineEntry().GetLine() == self.line1 and
+                        var.GetValue(frame0) == '3')
+
+        self.process.Kill()
+
+    def breakpoint_conditions_reused(self):
+        """Test that a condition whose code is reused is evaluated again on every hit."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target.IsValid(), VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByName('c', 'a.out')
+        self.assertTrue(breakpoint.IsValid() and
+                        breakpoint.GetNumLocations() == 1,
+                        VALID_BREAKPOINT)
+
+        # The condition is JIT compiled on the first hit and the same code
+        # is run again on the later ones. It is false, then true, then
+        # false again, so a result left over from an earlier hit would
+        # either never stop or stop at the wrong hit.
+        breakpoint.SetCondition('identity(val) == 2')
+
+        error = lldb.SBError()
+        self.process = target.Launch (self.dbg.GetListener(), None, None, os.ctermid(), os.ctermid(), os.ctermid(), None, 0, False, error)
+        self.process = target.GetProcess()
+        self.assertTrue(self.process.IsValid(), PROCESS_IS_VALID)
+
+        from lldbutil import get_stopped_thread
+        thread = get_stopped_thread(self.process, lldb.eStopReasonPlanComplete)
+        self.assertTrue(thread != None,
+                        "The reused condition should stop on the second hit")
+        frame0 = thread.GetFrameAtIndex(0)
+        var = frame0.FindValue('val', lldb.eValueTypeVariableArgument)
+        self.assertTrue(var.GetValue(frame0) == '2',
+                        "The reused condition should stop when val is 2")
+        self.assertTrue(breakpoint.GetHitCount() == 2)
+
+        # The third hit has val == 3, so the process runs to completion.
+        self.process.Continue()
+        self.assertTrue(self.process.GetState() == lldb.eStateExited, PROCESS_EXITED)
+        self.assertTrue(breakpoint.GetHitCount() == 3)
+
         
 if __name__ == '__main__':
     import atexit
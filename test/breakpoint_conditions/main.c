@@ -15,6 +15,7 @@
 int a(int);
 int b(int);
 int c(int);
+int identity(int);
 
 int a(int val)
 {
@@ -36,6 +37,13 @@ int c(int val)
     return val + 3; // Find the line number of function "c" here.
 }
 
+// Calling this from a condition means the condition can't be interpreted
+// by lldb and has to be run in the target.
+int identity(int val)
+{
+    return val;
+}
+
 int main (int argc, char const *argv[])
 {
     int A1 = a(1);  // a(1) -> b(1) -> c(1)
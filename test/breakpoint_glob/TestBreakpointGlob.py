@@ -0,0 +1,74 @@
+"""
+Test breakpoints set with a function name glob (breakpoint set --func-glob).
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class BreakpointGlobTestCase(TestBase):
+
+    mydir = "breakpoint_glob"
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    def test_with_dsym(self):
+        """Test that function name globs match C++ names without their argument lists."""
+        self.buildDsym()
+        self.breakpoint_glob_test()
+
+    def test_with_dwarf(self):
+        """Test that function name globs match C++ names without their argument lists."""
+        self.buildDwarf()
+        self.breakpoint_glob_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside ns::Handler().
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def breakpoint_glob_test(self):
+        """Test that function name globs match C++ names without their argument lists."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # A glob without wildcards must match the whole qualified name, the
+        # argument list of the demangled name isn't part of it.
+        self.expect("breakpoint set --func-glob ns::Handler", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: glob = 'ns::Handler', locations = 1")
+
+        # '?' matches exactly one character: ns::Handler and ns::Handles.
+        self.expect("breakpoint set -G ns::Handle?", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 2: glob = 'ns::Handle?', locations = 2")
+
+        # '*' can match nothing as well.
+        self.expect("breakpoint set -G ns::Handler*", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 3: glob = 'ns::Handler*', locations = 1")
+
+        # Sets of characters.
+        self.expect("breakpoint set -G ns::Handle[rs]", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 4: glob = 'ns::Handle[rs]', locations = 2")
+
+        # Nothing in the namespace matches this one.
+        self.expect("breakpoint set -G ns::Handle", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 5: glob = 'ns::Handle', locations = 0")
+
+        self.runCmd("breakpoint delete 2 3 4 5")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # We should stop in ns::Handler, not in the global Handler.
+        self.expect("thread backtrace", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ["stop reason = breakpoint 1."],
+            patterns = ["frame #0: .*a.out`ns::Handler"])
+
+        self.expect("breakpoint list -f", BREAKPOINT_HIT_ONCE,
+            substrs = [" resolved, hit count = 1"])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
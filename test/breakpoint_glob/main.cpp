@@ -0,0 +1,45 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include <stdio.h>
+
+namespace ns {
+
+    int
+    Handler (int x)
+    {
+        return x + 1;   // Set break point at this line.
+    }
+
+    int
+    Handles (int x)
+    {
+        return x + 2;
+    }
+
+    int
+    Other (int x)
+    {
+        return x + 3;
+    }
+}
+
+int
+Handler (int x)
+{
+    return x * 2;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int result = ns::Handler (argc) + ns::Handles (argc) + ns::Other (argc) + Handler (argc);
+    printf ("result = %d\n", result);
+    return 0;
+}
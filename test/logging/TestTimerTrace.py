@@ -0,0 +1,61 @@
+"""
+Test that "log timers trace" records a trace that "log timers dump-trace" writes out.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class TimerTraceTestCase(TestBase):
+
+    mydir = "logging"
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    def test_with_dsym (self):
+        self.buildDsym ()
+        self.timer_trace_tests ("dsym")
+
+    def test_with_dwarf (self):
+        self.buildDwarf ()
+        self.timer_trace_tests ("dwarf")
+
+    def timer_trace_tests (self, type):
+        trace_file = os.path.join (os.getcwd(), "lldb-timer-trace-%s-%s-%s.json" % (type,
+                                                                                    self.getCompiler(),
+                                                                                    self.getArchitecture()))
+
+        if (os.path.exists (trace_file)):
+            os.remove (trace_file)
+
+        # Trace without "log timers enable" so the trace doesn't depend
+        # on the display depth.
+        self.runCmd ("log timers trace true")
+        self.addTearDownHook (lambda: self.runCmd ("log timers trace false"))
+
+        exe = os.path.join (os.getcwd(), "a.out")
+        self.expect("file " + exe,
+                    patterns = [ "Current executable set to .*a.out" ])
+
+        self.runCmd ("breakpoint set -n main")
+
+        self.runCmd ("log timers dump-trace " + trace_file)
+
+        self.assertTrue (os.path.isfile (trace_file))
+
+        f = open (trace_file)
+        trace = f.read()
+        f.close ()
+        os.remove (trace_file)
+
+        self.assertTrue (trace.startswith ('{"traceEvents":['),
+                         "Trace file starts with the trace event list")
+        self.assertTrue ('"ph":"X"' in trace,
+                         "Trace file contains at least one complete event")
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -51,6 +51,21 @@ class ProcessAPITestCase(TestBase):
         self.buildDwarf()
         self.access_my_int()
 
+    # The packet statistics come from the gdb-remote process plugin.
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    def test_packet_stats_with_dsym(self):
+        """Test Python SBProcess.ExecutePluginCommand() and 'process plugin packet-stats'."""
+        self.buildDsym()
+        self.packet_stats()
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    def test_packet_stats_with_dwarf(self):
+        """Test Python SBProcess.ExecutePluginCommand() and 'process plugin packet-stats'."""
+        self.buildDwarf()
+        self.packet_stats()
+
     def setUp(self):
         # Call super's setUp().
         TestBase.setUp(self)
@@ -230,6 +245,54 @@ class ProcessAPITestCase(TestBase):
         for i in new_bytes:
             print "byte:", i
 
+    def packet_stats(self):
+        """Test Python SBProcess.ExecutePluginCommand() and 'process plugin packet-stats'."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target.IsValid(), VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation("main.cpp", self.line)
+        self.assertTrue(breakpoint.IsValid(), VALID_BREAKPOINT)
+
+        # Launch the process, and do not stop at the entry point.
+        error = lldb.SBError()
+        self.process = target.Launch (self.dbg.GetListener(), None, None, os.ctermid(), os.ctermid(), os.ctermid(), None, 0, False, error)
+
+        thread = get_stopped_thread(self.process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread != None, "There should be a thread stopped due to breakpoint")
+
+        # Getting to the breakpoint took plenty of packets, including
+        # memory reads which get a response.
+        stream = lldb.SBStream()
+        error = self.process.ExecutePluginCommand("packet-stats", stream)
+        self.assertTrue(error.Success(), "SBProcess.ExecutePluginCommand('packet-stats') succeeds")
+        self.expect(stream.GetData(), "Packet statistics are dumped",
+                    exe=False,
+            substrs = ["type       sent  bytes sent  responses",
+                       "'m' ",
+                       "'m' round trips:"])
+
+        # The same statistics are available from the command line.
+        self.expect("process plugin packet-stats dump",
+            substrs = ["type       sent  bytes sent  responses",
+                       "'m' round trips:"])
+
+        # After a reset only the byte totals are left.
+        stream = lldb.SBStream()
+        error = self.process.ExecutePluginCommand("packet-stats reset", stream)
+        self.assertTrue(error.Success(), "SBProcess.ExecutePluginCommand('packet-stats reset') succeeds")
+        self.expect("process plugin packet-stats", matching=False,
+            substrs = ["round trips:"])
+
+        # Unknown commands are an error.
+        stream = lldb.SBStream()
+        error = self.process.ExecutePluginCommand("no-such-command", stream)
+        self.assertTrue(error.Fail(), "SBProcess.ExecutePluginCommand() fails for an unknown command")
+        self.expect("process plugin packet-stats bogus", error=True,
+            substrs = ["usage: packet-stats [dump | reset]"])
+
 
 if __name__ == '__main__':
     import atexit
@@ -57,6 +57,11 @@
 #define FLOAT(n, d)     std::setfill(' ') << std::setw((n)+(d)+1) << std::setprecision(d) << std::showpoint << std::fixed
 #define INDENT_WITH_SPACES(iword_idx)   std::setfill(' ') << std::setw((iword_idx)) << ""
 #define INDENT_WITH_TABS(iword_idx)     std::setfill('\t') << std::setw((iword_idx)) << ""
+
+// Only run-length encode payloads at least this big; smaller ones are
+// cheap to send as is.
+#define RLE_MIN_PAYLOAD_SIZE    64
+
 // Class to handle communications via gdb remote protocol.
 
 extern void ASLLogCallback(void *baton, uint32_t flags, const char *format, va_list args);
@@ -76,6 +81,7 @@ RNBRemote::RNBRemote () :
     m_max_payload_size(DEFAULT_GDB_REMOTE_PROTOCOL_BUFSIZE - 4),
     m_extended_mode(false),
     m_noack_mode(false),
+    m_rle_mode(false),
     m_thread_suffix_supported (false),
     m_use_native_regs (false)
 {
@@ -168,6 +174,7 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (query_shlib_notify_info_addr,  &RNBRemote::HandlePacket_qShlibInfoAddr,NULL, "qShlibInfoAddr", "Returns the address that contains info needed for getting shared library notifications"));
     t.push_back (Packet (query_step_packet_supported,   &RNBRemote::HandlePacket_qStepPacketSupported,NULL, "qStepPacketSupported", "Replys with OK if the 's' packet is supported."));
     t.push_back (Packet (query_host_info,               &RNBRemote::HandlePacket_qHostInfo,     NULL, "qHostInfo", "Replies with multiple 'key:value;' tuples appended to each other."));
+    t.push_back (Packet (query_supported,               &RNBRemote::HandlePacket_qSupported,    NULL, "qSupported", "Exchange the lists of optional protocol features that each side supports."));
 //  t.push_back (Packet (query_symbol_lookup,           &RNBRemote::HandlePacket_UNIMPLEMENTED, NULL, "qSymbol", "Notify that host debugger is ready to do symbol lookups"));
     t.push_back (Packet (start_noack_mode,              &RNBRemote::HandlePacket_QStartNoAckMode        , NULL, "QStartNoAckMode", "Request that " DEBUGSERVER_PROGRAM_NAME " stop acking remote protocol packets"));
     t.push_back (Packet (prefix_reg_packets_with_tid,   &RNBRemote::HandlePacket_QThreadSuffixSupported , NULL, "QThreadSuffixSupported", "Check if thread specifc packets (register packets 'g', 'G', 'p', and 'P') support having the thread ID appended to the end of the command"));
@@ -250,10 +257,56 @@ RNBRemote::SendSTDERRPacket (char *buf, nub_size_t buf_size)
     return SendHexEncodedBytePacket("O", buf, buf_size, NULL);
 }
 
+// Run-length encode "s" as the gdb remote protocol defines it: a run of
+// a character is sent as the character, a '*', and then a character
+// whose value is the number of extra copies plus 29. Runs are only
+// encoded when that is shorter, and counts that would be sent as '#' or
+// '$' are avoided.
+static std::string
+run_length_encode (const std::string &s)
+{
+    std::string encoded;
+    encoded.reserve (s.size());
+    const size_t size = s.size();
+    size_t i = 0;
+    while (i < size)
+    {
+        const char ch = s[i];
+        // The largest count we can send is '~' (126), which is 97 repeats
+        size_t repeat = 0;
+        while (i + repeat + 1 < size && s[i + repeat + 1] == ch && repeat < 97)
+            ++repeat;
+
+        encoded += ch;
+        if (repeat >= 3)
+        {
+            if (repeat == 6 || repeat == 7)
+                repeat = 5;
+            encoded += '*';
+            encoded += (char)(repeat + 29);
+        }
+        else
+        {
+            encoded.append (repeat, ch);
+        }
+        i += repeat + 1;
+    }
+    return encoded;
+}
+
 rnb_err_t
-RNBRemote::SendPacket (const std::string &s)
+RNBRemote::SendPacket (const std::string &payload)
 {
-    DNBLogThreadedIf (LOG_RNB_MAX, "%8d RNBRemote::%s (%s) called", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, s.c_str());
+    DNBLogThreadedIf (LOG_RNB_MAX, "%8d RNBRemote::%s (%s) called", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, payload.c_str());
+
+    // A '*' in a payload would be mistaken for an encoded run, so only
+    // encode payloads without one; debugserver doesn't send any to a
+    // debugger that asked for encoded packets anyway.
+    const bool encode = m_rle_mode && payload.size() >= RLE_MIN_PAYLOAD_SIZE && payload.find('*') == std::string::npos;
+    const std::string s (encode ? run_length_encode (payload) : payload);
+    if (encode)
+        DNBLogThreadedIf (LOG_RNB_PACKETS, "%8d RNBRemote::%s run-length encoded %zu bytes as %zu", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, payload.size(), s.size());
+
     std::string sendpacket = "$" + s + "#";
     int cksum = 0;
     char hexbuf[5];
@@ -2000,7 +2053,7 @@ RNBRemote::SendStopReplyPacketForThread (nub_thread_t tid)
         {
             size_t thread_name_len = strlen(thread_name);
             
-            if (::strcspn (thread_name, "$#+-;:") == thread_name_len)
+            if (::strcspn (thread_name, "$#+-;:*") == thread_name_len)
                 ostrm << std::hex << "name:" << thread_name << ';';
             else
             {
@@ -3291,6 +3344,36 @@ RNBRemote::HandlePacket_S (const char *p)
     return rnb_success;
 }
 
+rnb_err_t
+RNBRemote::HandlePacket_qSupported (const char *p)
+{
+    // The debugger sends a list of features it supports:
+    // "qSupported:feature+;feature-;feature=value..."
+    // Features are negotiated again by each qSupported, so forget the
+    // ones an earlier connection asked for.
+    m_rle_mode = false;
+
+    p += strlen ("qSupported");
+    if (*p == ':')
+        ++p;
+    while (*p)
+    {
+        size_t len = strcspn (p, ";");
+        if (len == strlen ("rle+") && strncmp (p, "rle+", len) == 0)
+            m_rle_mode = true;
+        p += len;
+        if (*p == ';')
+            ++p;
+    }
+
+    // Reply with the features we support
+    std::ostringstream strm;
+    strm << "QStartNoAckMode+;QThreadSuffixSupported+";
+    if (m_rle_mode)
+        strm << ";rle+";
+    return SendPacket (strm.str());
+}
+
 rnb_err_t
 RNBRemote::HandlePacket_qHostInfo (const char *p)
 {
@@ -91,6 +91,7 @@ public:
         query_shlib_notify_info_addr,   // 'qShlibInfoAddr'
         query_step_packet_supported,    // 'qStepPacketSupported'
         query_host_info,                // 'qHostInfo'
+        query_supported,                // 'qSupported'
         pass_signals_to_inferior,       // 'QPassSignals'
         start_noack_mode,               // 'QStartNoAckMode'
         prefix_reg_packets_with_tid,    // 'QPrefixRegisterPacketsWithThreadID
@@ -161,6 +162,7 @@ public:
     rnb_err_t HandlePacket_qThreadExtraInfo (const char *p);
     rnb_err_t HandlePacket_qThreadStopInfo (const char *p);
     rnb_err_t HandlePacket_qHostInfo (const char *p);
+    rnb_err_t HandlePacket_qSupported (const char *p);
     rnb_err_t HandlePacket_QStartNoAckMode (const char *p);
     rnb_err_t HandlePacket_QThreadSuffixSupported (const char *p);
     rnb_err_t HandlePacket_QSetLogging (const char *p);
@@ -309,6 +311,7 @@ protected:
     bool            m_extended_mode:1,   // are we in extended mode?
                     m_noack_mode:1,      // are we in no-ack mode?
                     m_noack_mode_just_enabled:1, // Did we just enable this and need to compute one more checksum?
+                    m_rle_mode:1,        // May we run-length encode the packets we send?
                     m_use_native_regs:1, // Use native registers by querying DNB layer for register definitions?
                     m_thread_suffix_supported:1; // Set to true if the 'p', 'P', 'g', and 'G' packets should be prefixed with the thread ID and colon:
                                                                 // "$pRR;thread:TTTT;" instead of "$pRR"